@@ -0,0 +1,336 @@
+// === Benchmarks da renderização ===
+// Mede as primitivas do ssd1306 (pixel, linha, caractere, texto), a composição de cada tela
+// do menu e o envio do quadro. O mesmo código roda na placa (tempo pelo timer de 1 MHz,
+// convertido em ciclos pelo clk_sys) e no PC, com o Pico SDK simulado (tempo pelo relógio
+// monotônico, sem ciclos).
+//
+// Cada medida repete a operação em lotes dobrando de tamanho até o lote levar pelo menos
+// BENCH_MIN_US; o tempo por operação inclui a chamada pelo ponteiro de função. O resultado
+// sai em JSON: no stdio USB, na placa, ou no arquivo dado como argumento, no PC.
+// bench/compare.py compara dois resultados e falha se algum piorou além da tolerância.
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/clocks.h"
+#include "inc/ssd1306.h"
+#include "display.h"
+#include "render.h"
+#include "listview.h"
+#include <stdio.h>
+#include <string.h>
+
+#if PICO_ON_DEVICE
+#include "pico/stdio_usb.h"
+#endif
+
+#define BENCH_MIN_US 50000
+#define BENCH_MAX_RESULTS 32
+#define BENCH_LIST_ROWS 32
+
+#define SDA_PIN 14
+#define SCL_PIN 15
+
+typedef struct {
+    const char* name;
+    const char* unit;
+    uint32_t iterations;
+    double ns_per_op;
+    int32_t bytes_full;      // bytes no barramento para um quadro inteiro (-1: não se aplica)
+    int32_t bytes_update;    // bytes no barramento para a mudança típica da tela
+} Result;
+
+static Result results[BENCH_MAX_RESULTS];
+static int n_results;
+static uint8_t buffer[ssd1306_buffer_length];
+
+static uint64_t now_us(void) {
+    return time_us_64();
+}
+
+// Repete fn até o lote levar BENCH_MIN_US; retorna o resultado registrado
+static Result* measure(const char* name, const char* unit, void (*fn)(uint32_t i)) {
+    uint32_t n = 1;
+    uint64_t elapsed;
+
+    while (1) {
+        uint64_t start = now_us();
+        for (uint32_t i = 0; i < n; i++) {
+            fn(i);
+        }
+        elapsed = now_us() - start;
+        if (elapsed >= BENCH_MIN_US || n >= 1u << 30) break;
+        n *= 2;
+    }
+
+    Result* r = &results[n_results++];
+    *r = (Result){name, unit, n, elapsed * 1000.0 / n, -1, -1};
+    return r;
+}
+
+// === Primitivas ===
+static void op_set_pixel(uint32_t i) {
+    ssd1306_set_pixel(buffer, i % ssd1306_width, (i / ssd1306_width) % ssd1306_height, i & 1);
+}
+
+static void op_line_diagonal(uint32_t i) {
+    if (i & 1) ssd1306_draw_line(buffer, 0, 0, ssd1306_width - 1, ssd1306_height - 1, true);
+    else ssd1306_draw_line(buffer, 0, ssd1306_height - 1, ssd1306_width - 1, 0, true);
+}
+
+static void op_line_horizontal(uint32_t i) {
+    int y = i % ssd1306_height;
+    ssd1306_draw_line(buffer, 0, y, ssd1306_width - 1, y, true);
+}
+
+static void op_line_vertical(uint32_t i) {
+    int x = i % ssd1306_width;
+    ssd1306_draw_line(buffer, x, 0, x, ssd1306_height - 1, true);
+}
+
+static void op_draw_char(uint32_t i) {
+    ssd1306_draw_char(buffer, (i % 16) * 8, (i / 16 % 8) * 8, 'A' + i % 26);
+}
+
+static void op_draw_string(uint32_t i) {
+    ssd1306_draw_string(buffer, 0, (i % 8) * 8, "LEMBRETES MED 12");
+}
+
+// Fora do múltiplo de 8 (duas páginas por glifo), com minúsculas e acentos em UTF-8
+static void op_draw_string_shifted(uint32_t i) {
+    ssd1306_draw_string(buffer, 0, 3 + (i % 7) * 8, "Lembrete às 07:30");
+}
+
+static void op_draw_string_proportional(uint32_t i) {
+    ssd1306_set_font(&ssd1306_font_proportional);
+    ssd1306_draw_string(buffer, 0, 3 + (i % 7) * 8, "Lembrete às 07:30");
+    ssd1306_set_font(&ssd1306_font_fixed);
+}
+
+// Primitivas de faixa e as mesmas áreas desenhadas pixel a pixel, para comparar
+static void op_fill_rect(uint32_t i) {
+    ssd1306_fill_rect(buffer, 0, 0, ssd1306_width, ssd1306_height, i & 1);
+}
+
+static void op_fill_rect_pixels(uint32_t i) {
+    for (int y = 0; y < ssd1306_height; y++) {
+        for (int x = 0; x < ssd1306_width; x++) {
+            ssd1306_set_pixel(buffer, x, y, i & 1);
+        }
+    }
+}
+
+static void op_hline(uint32_t i) {
+    ssd1306_draw_hline(buffer, 0, ssd1306_width - 1, i % ssd1306_height, true);
+}
+
+static void op_hline_pixels(uint32_t i) {
+    for (int x = 0; x < ssd1306_width; x++) {
+        ssd1306_set_pixel(buffer, x, i % ssd1306_height, true);
+    }
+}
+
+static void op_vline(uint32_t i) {
+    ssd1306_draw_vline(buffer, i % ssd1306_width, 0, ssd1306_height - 1, true);
+}
+
+static void op_draw_rect(uint32_t i) {
+    ssd1306_draw_rect(buffer, i % 8, i % 16, 100, 40, true);
+}
+
+// Barra de seleção de uma linha da lista
+static void op_invert_rect(uint32_t i) {
+    ssd1306_invert_rect(buffer, 0, i % (ssd1306_height - 12), ssd1306_width, 12);
+}
+
+static void op_invert_rect_pixels(uint32_t i) {
+    int top = i % (ssd1306_height - 12);
+    for (int y = top; y < top + 12; y++) {
+        for (int x = 0; x < ssd1306_width; x++) {
+            int idx = (y / 8) * ssd1306_width + x;
+            ssd1306_set_pixel(buffer, x, y, !(buffer[idx] & (1 << (y % 8))));
+        }
+    }
+}
+
+// Ícone de 16x16 em qualquer altura (duas páginas de origem por página de destino)
+static void op_blit(uint32_t i) {
+    static const uint8_t icon[32] = {
+        0x00, 0xF8, 0x04, 0x02, 0x02, 0xF2, 0x82, 0x82, 0x82, 0x82, 0x02, 0x02, 0x04, 0xF8, 0x00, 0x00,
+        0x00, 0x1F, 0x20, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x20, 0x1F, 0x00, 0x00,
+    };
+    ssd1306_blit(buffer, (i * 16) % ssd1306_width, i % (ssd1306_height - 16), icon, 16, 16);
+}
+
+// === Telas ===
+// Mesmos comandos (e posições) que disp_menu() e disp_alert() em main.c enviam ao display
+static void compose(const DisplayCmd* cmds, int n) {
+    uint8_t* back = ssd1306_draw_buffer();
+    for (int i = 0; i < n; i++) {
+        render_command(back, &cmds[i]);
+    }
+}
+
+static DisplayCmd text(uint8_t x, uint8_t y, const char* s) {
+    DisplayCmd cmd = {.type = DISPLAY_CMD_TEXT, .x = x, .y = y};
+    snprintf(cmd.text, sizeof cmd.text, "%s", s);
+    return cmd;
+}
+
+static const DisplayCmd clear_all = {.type = DISPLAY_CMD_CLEAR, .w = ssd1306_width, .h = ssd1306_height};
+
+static void screen_home(uint32_t i) {
+    (void)i;
+    DisplayCmd cmds[] = {
+        clear_all,
+        text(5, 5, "LEMBRETES MED"),
+        text(5, 20, "A ADICIONAR"),
+        text(5, 35, "B VER LEMBRETES"),
+    };
+    compose(cmds, count_of(cmds));
+}
+
+static void screen_add(uint32_t i) {
+    char time[22];
+    snprintf(time, sizeof time, "%02d:%02d %s", 12, (int)(i % 60), "DIARIO");
+    DisplayCmd cmds[] = {
+        clear_all,
+        text(5, 5, "NOVO LEMBRETE"),
+        text(5, 20, time),
+        text(0, 35, "A SALVA B REPETE"),
+    };
+    compose(cmds, count_of(cmds));
+}
+
+static void screen_list(uint32_t i) {
+    DisplayCmd cmds[] = {
+        clear_all,
+        {.type = DISPLAY_CMD_LIST, .arg = i % BENCH_LIST_ROWS},
+        text(5, 56, "VOLTAR: BOTAO A"),
+    };
+    compose(cmds, count_of(cmds));
+}
+
+static void screen_alert(uint32_t i) {
+    (void)i;
+    char msg[22];
+    snprintf(msg, sizeof msg, "TOMAR: %s", "MEDICAMENTO");
+    DisplayCmd cmds[] = {
+        clear_all,
+        text(10, 10, "ALERTA!"),
+        text(10, 30, msg),
+        text(10, 50, "A: OK | B: Adiar"),
+    };
+    compose(cmds, count_of(cmds));
+}
+
+// Lista de lembretes fictícios, com o mesmo formato de linha de main.c
+static int list_count(void) {
+    return BENCH_LIST_ROWS;
+}
+
+static uint32_t list_key(int pos) {
+    return pos;
+}
+
+static void list_format(int pos, char* s, int len) {
+    snprintf(s, len, "%02d:%02d %s", pos % 24, pos * 7 % 60, "MEDICAMENTO");
+}
+
+static const ListSource bench_list = {list_count, list_key, list_format};
+
+// Bytes entregues ao transporte (preâmbulos, dados e endereços) por um envio do quadro de trás
+static int32_t flush_bytes(void) {
+    uint32_t before = i2c_bus_get_stats()->bytes;
+    ssd1306_flush_async();
+    ssd1306_flush_wait();
+    return i2c_bus_get_stats()->bytes - before;
+}
+
+// Mede a composição da tela e o que vai ao barramento: o quadro inteiro e a passagem da
+// variante 0 para a 1 (o minuto na inclusão, a seleção na lista)
+static void bench_screen(const char* name, void (*screen)(uint32_t i)) {
+    Result* r = measure(name, "frame", screen);
+
+    screen(0);
+    ssd1306_invalidate();
+    r->bytes_full = flush_bytes();
+    screen(1);
+    r->bytes_update = flush_bytes();
+}
+
+static void op_flush_full(uint32_t i) {
+    (void)i;
+    ssd1306_invalidate();
+    ssd1306_flush_async();
+    ssd1306_flush_wait();
+}
+
+// === Relatório ===
+static void report(FILE* out) {
+    uint32_t hz = clock_get_hz(clk_sys);
+
+    fprintf(out, "{\n  \"target\": \"%s\",\n", PICO_ON_DEVICE ? "rp2040" : "host");
+    fprintf(out, "  \"clk_sys_hz\": %lu,\n  \"results\": [\n", PICO_ON_DEVICE ? (unsigned long)hz : 0ul);
+    for (int i = 0; i < n_results; i++) {
+        const Result* r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"unit\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.1f",
+                r->name, r->unit, (unsigned long)r->iterations, r->ns_per_op);
+        if (PICO_ON_DEVICE) fprintf(out, ", \"cycles_per_op\": %.1f", r->ns_per_op * hz / 1e9);
+        if (r->bytes_full >= 0) {
+            fprintf(out, ", \"bytes_full\": %ld, \"bytes_update\": %ld", (long)r->bytes_full, (long)r->bytes_update);
+        }
+        fprintf(out, "}%s\n", i + 1 < n_results ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    stdio_init_all();
+    i2c_bus_init(i2c1, SDA_PIN, SCL_PIN, ssd1306_i2c_clock * 1000);
+    ssd1306_init();
+    listview_set_source(&bench_list);
+
+#if PICO_ON_DEVICE
+    // Espera o terminal abrir a porta USB para não perder o relatório
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+#endif
+
+    measure("set_pixel", "pixel", op_set_pixel);
+    measure("draw_line_diagonal", "line", op_line_diagonal);
+    measure("draw_line_horizontal", "line", op_line_horizontal);
+    measure("draw_line_vertical", "line", op_line_vertical);
+    measure("fill_rect_screen", "rect", op_fill_rect);
+    measure("fill_rect_screen_pixels", "rect", op_fill_rect_pixels);
+    measure("draw_hline", "line", op_hline);
+    measure("draw_hline_pixels", "line", op_hline_pixels);
+    measure("draw_vline", "line", op_vline);
+    measure("draw_rect_100x40", "rect", op_draw_rect);
+    measure("invert_rect_row", "rect", op_invert_rect);
+    measure("invert_rect_row_pixels", "rect", op_invert_rect_pixels);
+    measure("blit_16x16", "bitmap", op_blit);
+    measure("draw_char", "char", op_draw_char);
+    measure("draw_string_16", "string", op_draw_string);
+    measure("draw_string_shifted", "string", op_draw_string_shifted);
+    measure("draw_string_proportional", "string", op_draw_string_proportional);
+    bench_screen("frame_home", screen_home);
+    bench_screen("frame_add", screen_add);
+    bench_screen("frame_list", screen_list);
+    bench_screen("frame_alert", screen_alert);
+    measure("flush_full", "frame", op_flush_full);
+
+    FILE* out = stdout;
+#if !PICO_ON_DEVICE
+    if (argc > 1 && !(out = fopen(argv[1], "w"))) {
+        perror(argv[1]);
+        return 1;
+    }
+#endif
+    report(out);
+    if (out != stdout) fclose(out);
+
+    while (PICO_ON_DEVICE) {
+        sleep_ms(1000);
+    }
+    return 0;
+}
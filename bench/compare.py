@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Compara dois resultados de bench/bench.c e falha se algum piorou.
+
+Uso: compare.py BASE.json ATUAL.json [--tolerance PCT]
+O tempo por operação (ns, e ciclos quando houver) pode subir até a tolerância (padrão 10%);
+os bytes enviados ao display não podem subir. Sai com código 1 se houver regressão.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {r["name"]: r for r in json.load(f)["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("base")
+    parser.add_argument("current")
+    parser.add_argument("--tolerance", type=float, default=10.0)
+    args = parser.parse_args()
+
+    base, current = load(args.base), load(args.current)
+    failed = False
+    print(f"{'medida':24} {'base':>12} {'atual':>12} {'variacao':>9}")
+    for name, cur in current.items():
+        old = base.get(name)
+        if old is None:
+            print(f"{name:24} {'-':>12} {cur['ns_per_op']:>10.1f}ns     nova")
+            continue
+
+        change = (cur["ns_per_op"] / old["ns_per_op"] - 1) * 100 if old["ns_per_op"] else 0.0
+        worse = change > args.tolerance
+        for key in ("bytes_full", "bytes_update"):
+            if key in cur and key in old and cur[key] > old[key]:
+                print(f"{name:24} {key}: {old[key]} -> {cur[key]} bytes")
+                worse = True
+        failed |= worse
+        print(f"{name:24} {old['ns_per_op']:>10.1f}ns {cur['ns_per_op']:>10.1f}ns {change:>+8.1f}%"
+              f"{'  REGRESSAO' if worse else ''}")
+
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
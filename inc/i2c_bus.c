@@ -0,0 +1,156 @@
+// === Transporte I2C ===
+// Dono das configurações do barramento do display: frequência, prazos, detecção de NAK e
+// recuperação. Uma escrita nunca espera para sempre: o prazo sai do número de bytes e da
+// frequência, e um escravo que segura o SDA (conector com mau contato, reset no meio de um
+// byte) é solto com pulsos de SCL gerados pelo GPIO. Falhas seguidas descem a frequência
+// (1 MHz -> 400 kHz -> 100 kHz), de modo que o painel roda no mais rápido que o barramento
+// aguenta.
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+// Meio período do clock gerado à mão na recuperação (~100 kHz)
+#define I2C_BUS_RECOVERY_HALF_US 5
+
+static i2c_inst_t *bus_i2c;
+static uint bus_sda, bus_scl;
+static volatile uint bus_requested;     // frequência pedida, 0 se nenhum pedido
+static int bus_failures;                // falhas seguidas
+static struct i2c_bus_stats bus_stats;
+
+// Linha em dreno aberto: em 0 o pino é saída baixa; em 1 é solto e o pull-up o leva para cima
+static void i2c_bus_line(uint pin, bool high) {
+    gpio_set_dir(pin, high ? GPIO_IN : GPIO_OUT);
+    busy_wait_us_32(I2C_BUS_RECOVERY_HALF_US);
+}
+
+static void i2c_bus_pins(enum gpio_function function) {
+    gpio_set_function(bus_sda, function);
+    gpio_set_function(bus_scl, function);
+    gpio_pull_up(bus_sda);
+    gpio_pull_up(bus_scl);
+}
+
+void i2c_bus_recover() {
+    i2c_deinit(bus_i2c);
+
+    gpio_init(bus_sda);
+    gpio_init(bus_scl);
+    i2c_bus_pins(GPIO_FUNC_SIO);
+    gpio_put(bus_sda, 0);
+    gpio_put(bus_scl, 0);
+    i2c_bus_line(bus_sda, true);
+    i2c_bus_line(bus_scl, true);
+
+    // O escravo termina o byte que estava mandando a cada pulso; com o SDA solto, o STOP o libera
+    for (int i = 0; i < 9 && !gpio_get(bus_sda); i++) {
+        i2c_bus_line(bus_scl, false);
+        i2c_bus_line(bus_scl, true);
+    }
+    i2c_bus_line(bus_scl, false);
+    i2c_bus_line(bus_sda, false);
+    i2c_bus_line(bus_scl, true);
+    i2c_bus_line(bus_sda, true);
+
+    bus_stats.recoveries++;
+    if (!gpio_get(bus_sda)) {
+        bus_stats.stuck++;
+    }
+
+    bus_stats.baudrate = i2c_init(bus_i2c, bus_stats.baudrate);
+    i2c_bus_pins(GPIO_FUNC_I2C);
+}
+
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate) {
+    bus_i2c = i2c;
+    bus_sda = sda;
+    bus_scl = scl;
+    bus_stats.baudrate = baudrate;
+
+    // Um reset no meio de uma transação pode ter deixado o display segurando o SDA
+    i2c_bus_recover();
+    bus_stats.recoveries = 0;
+    bus_stats.stuck = 0;
+}
+
+i2c_inst_t *i2c_bus_inst() {
+    return bus_i2c;
+}
+
+void i2c_bus_request_baudrate(uint baudrate) {
+    bus_requested = baudrate;
+}
+
+// Chamada pelo dono do barramento com ele parado
+void i2c_bus_apply() {
+    uint baudrate = bus_requested;
+    if (baudrate == 0) {
+        return;
+    }
+    bus_requested = 0;
+    bus_failures = 0;
+    bus_stats.baudrate = i2c_set_baudrate(bus_i2c, baudrate);
+}
+
+uint32_t i2c_bus_timeout_us(uint32_t bytes) {
+    return (uint32_t)((uint64_t)bytes * 9 * 2 * 1000000 / bus_stats.baudrate) + I2C_BUS_TIMEOUT_MARGIN_US;
+}
+
+void i2c_bus_account(uint32_t transactions, uint32_t bytes) {
+    bus_stats.transactions += transactions;
+    bus_stats.bytes += bytes;
+}
+
+bool i2c_bus_busy() {
+    return i2c_get_hw(bus_i2c)->status & I2C_IC_STATUS_ACTIVITY_BITS;
+}
+
+// Resultado da última transação escrita por fora: o bloco aborta (e descarta a FIFO) no NAK
+int i2c_bus_check() {
+    i2c_hw_t *hw = i2c_get_hw(bus_i2c);
+    if (!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+        return PICO_OK;
+    }
+    (void)hw->clr_tx_abrt;
+    return PICO_ERROR_GENERIC;
+}
+
+// Transação completa: a sequência de falhas que desce a frequência recomeça
+void i2c_bus_ok() {
+    bus_failures = 0;
+}
+
+// Conta a falha e recupera o barramento; falhas seguidas descem a frequência
+void i2c_bus_fail(int error) {
+    if (error == PICO_ERROR_TIMEOUT) {
+        bus_stats.timeouts++;
+    } else {
+        bus_stats.naks++;
+    }
+
+    if (++bus_failures >= I2C_BUS_MAX_FAILURES && bus_stats.baudrate > I2C_BUS_STANDARD) {
+        bus_stats.baudrate = bus_stats.baudrate > I2C_BUS_FAST ? I2C_BUS_FAST : I2C_BUS_STANDARD;
+        bus_stats.downshifts++;
+        bus_failures = 0;
+    }
+    i2c_bus_recover();
+}
+
+int i2c_bus_write(uint8_t address, const uint8_t *data, size_t length, bool nostop) {
+    int result = PICO_ERROR_GENERIC;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        result = i2c_write_timeout_us(bus_i2c, address, data, length, nostop, i2c_bus_timeout_us(length + 1));
+        i2c_bus_account(1, length + 1);
+        if (result == (int)length) {
+            i2c_bus_ok();
+            return result;
+        }
+        i2c_bus_fail(result);
+    }
+    return result;
+}
+
+const struct i2c_bus_stats *i2c_bus_get_stats() {
+    return &bus_stats;
+}
@@ -0,0 +1,55 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifndef i2c_bus_inc_h
+#define i2c_bus_inc_h
+
+// Frequências do barramento: Standard, Fast e Fast-mode Plus
+#define I2C_BUS_STANDARD 100000
+#define I2C_BUS_FAST 400000
+#define I2C_BUS_FAST_PLUS 1000000
+
+// Prazo de uma transação: o dobro do tempo dos bytes (9 bits cada) mais esta margem para o
+// alongamento de clock do escravo
+#define I2C_BUS_TIMEOUT_MARGIN_US 1000
+
+// Falhas seguidas (após a recuperação) que fazem o barramento descer para a frequência abaixo
+#define I2C_BUS_MAX_FAILURES 3
+
+// Contadores do barramento; bytes incluem o de endereço de cada transação
+struct i2c_bus_stats {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t naks;          // endereço ou dado sem ACK
+    uint32_t timeouts;      // transação que não terminou no prazo
+    uint32_t recoveries;    // pulsos de SCL e STOP gerados à mão
+    uint32_t stuck;         // recuperações em que o SDA continuou em 0
+    uint32_t downshifts;    // descidas de frequência por falhas seguidas
+    uint32_t baudrate;      // frequência efetiva
+};
+
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate);
+i2c_inst_t *i2c_bus_inst();
+
+// Pede uma nova frequência; o dono do barramento a aplica com i2c_bus_apply entre transações
+void i2c_bus_request_baudrate(uint baudrate);
+void i2c_bus_apply();
+
+// Escrita bloqueante com prazo; em NAK ou estouro do prazo, recupera o barramento e tenta
+// mais uma vez. Retorna o número de bytes ou um PICO_ERROR_*
+int i2c_bus_write(uint8_t address, const uint8_t *data, size_t length, bool nostop);
+
+// Transações escritas por fora (DMA em IC_DATA_CMD): contagem, prazo e resultado
+void i2c_bus_account(uint32_t transactions, uint32_t bytes);
+uint32_t i2c_bus_timeout_us(uint32_t bytes);
+bool i2c_bus_busy();
+int i2c_bus_check();
+void i2c_bus_ok();
+void i2c_bus_fail(int error);
+
+// Solta um escravo preso no meio de um byte: até 9 pulsos de SCL, STOP e o bloco reiniciado
+void i2c_bus_recover();
+
+const struct i2c_bus_stats *i2c_bus_get_stats();
+
+#endif
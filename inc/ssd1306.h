@@ -1,16 +1,38 @@
 #include "ssd1306_i2c.h"
+#include "i2c_bus.h"
 extern void calculate_render_area_buffer_length(struct render_area *area);
-extern void ssd1306_send_command(uint8_t cmd);
-extern void ssd1306_send_command_list(uint8_t *ssd, int number);
-extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
-extern void ssd1306_init();
-extern void ssd1306_scroll(bool set);
-extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern bool ssd1306_send_command(uint8_t cmd);
+extern bool ssd1306_send_command_list(uint8_t *ssd, int number);
+extern bool ssd1306_send_command_stream(const uint8_t *commands, int number);
+extern bool ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
+extern bool ssd1306_init();
+extern bool ssd1306_scroll(bool set);
+extern bool render_on_display(uint8_t *ssd, struct render_area *area);
+extern bool ssd1306_flush_busy();
+extern bool ssd1306_flush_wait();
+extern void ssd1306_set_flush_callback(ssd1306_flush_callback_t callback, void *ctx);
+extern uint8_t *ssd1306_draw_buffer();
+extern void ssd1306_invalidate();
+extern bool ssd1306_flush_async();
+extern void ssd1306_flush(uint8_t *ssd);
+extern const struct ssd1306_flush_stats *ssd1306_get_flush_stats();
 extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
 extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, bool set);
+extern void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, bool set);
+extern void ssd1306_rect_op(uint8_t *ssd, int x, int y, int w, int h, enum ssd1306_op op);
+extern void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int w, int h, bool set);
+extern void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int w, int h, bool set);
+extern void ssd1306_invert_rect(uint8_t *ssd, int x, int y, int w, int h);
+extern void ssd1306_blit(uint8_t *ssd, int x, int y, const uint8_t *bitmap, int w, int h);
 extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
 extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
+extern const ssd1306_font_t ssd1306_font_fixed;
+extern const ssd1306_font_t ssd1306_font_proportional;
+extern void ssd1306_set_font(const ssd1306_font_t *f);
+extern int ssd1306_string_width(const char *string);
 extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+extern void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number, bool nostop);
 extern void ssd1306_config(ssd1306_t *ssd);
 extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 extern void ssd1306_send_data(ssd1306_t *ssd);
@@ -1,6 +1,42 @@
 
-static uint8_t font[] = {
+// Fonte 8x8: cada glifo são 8 colunas (bytes de página, bit 0 em cima). As maiúsculas e os
+// dígitos ocupam 7 colunas; os demais glifos, 5 colunas centralizadas. As minúsculas acentuadas
+// levam o acento nas linhas 0 e 1 e as maiúsculas acentuadas são desenhadas em 6 linhas.
+static const uint8_t font[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // espaco
+    0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00, // !
+    0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, // "
+    0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00, // #
+    0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00, // $
+    0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00, // %
+    0x00, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x00, // &
+    0x00, 0x00, 0x05, 0x03, 0x00, 0x00, 0x00, 0x00, // '
+    0x00, 0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00, // (
+    0x00, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00, // )
+    0x00, 0x2a, 0x1c, 0x7f, 0x1c, 0x2a, 0x00, 0x00, // *
+    0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, // +
+    0x00, 0x00, 0x50, 0x30, 0x00, 0x00, 0x00, 0x00, // ,
+    0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, // -
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, // .
+    0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00, // /
+    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
+    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
+    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
+    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
+    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
+    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
+    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
+    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
+    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
+    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
+    0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, // :
+    0x00, 0x00, 0x56, 0x36, 0x00, 0x00, 0x00, 0x00, // ;
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00, // <
+    0x00, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00, // =
+    0x00, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00, // >
+    0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00, // ?
+    0x00, 0x32, 0x49, 0x79, 0x41, 0x3e, 0x00, 0x00, // @
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
     0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
     0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
@@ -27,14 +63,104 @@ static uint8_t font[] = {
     0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
     0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
     0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
-};
\ No newline at end of file
+    0x00, 0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00, // [
+    0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00, // barra invertida
+    0x00, 0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00, // ]
+    0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00, // ^
+    0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, // _
+    0x00, 0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, // `
+    0x00, 0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, // a
+    0x00, 0x7f, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00, // b
+    0x00, 0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, // c
+    0x00, 0x38, 0x44, 0x44, 0x48, 0x7f, 0x00, 0x00, // d
+    0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, // e
+    0x00, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x00, // f
+    0x00, 0x0c, 0x52, 0x52, 0x52, 0x3e, 0x00, 0x00, // g
+    0x00, 0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, // h
+    0x00, 0x00, 0x44, 0x7d, 0x40, 0x00, 0x00, 0x00, // i
+    0x00, 0x20, 0x40, 0x44, 0x3d, 0x00, 0x00, 0x00, // j
+    0x00, 0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, // k
+    0x00, 0x00, 0x41, 0x7f, 0x40, 0x00, 0x00, 0x00, // l
+    0x00, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, // m
+    0x00, 0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, // n
+    0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, // o
+    0x00, 0x7c, 0x14, 0x14, 0x14, 0x08, 0x00, 0x00, // p
+    0x00, 0x08, 0x14, 0x14, 0x18, 0x7c, 0x00, 0x00, // q
+    0x00, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00, // r
+    0x00, 0x48, 0x54, 0x54, 0x54, 0x20, 0x00, 0x00, // s
+    0x00, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x00, 0x00, // t
+    0x00, 0x3c, 0x40, 0x40, 0x20, 0x7c, 0x00, 0x00, // u
+    0x00, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00, 0x00, // v
+    0x00, 0x3c, 0x40, 0x30, 0x40, 0x3c, 0x00, 0x00, // w
+    0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, // x
+    0x00, 0x0c, 0x50, 0x50, 0x50, 0x3c, 0x00, 0x00, // y
+    0x00, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00, // z
+    0x00, 0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00, // {
+    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // |
+    0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00, // }
+    0x00, 0x08, 0x04, 0x08, 0x10, 0x08, 0x00, 0x00, // ~
+    0x00, 0x48, 0x55, 0x55, 0x5e, 0x00, 0x00, 0x00, // ª
+    0x00, 0x00, 0x06, 0x09, 0x09, 0x06, 0x00, 0x00, // °
+    0x00, 0x26, 0x29, 0x29, 0x26, 0x00, 0x00, 0x00, // º
+    0x00, 0xf8, 0x25, 0x26, 0x24, 0xf8, 0x00, 0x00, // À
+    0x00, 0xf8, 0x24, 0x26, 0x25, 0xf8, 0x00, 0x00, // Á
+    0x00, 0xf8, 0x26, 0x25, 0x26, 0xf8, 0x00, 0x00, // Â
+    0x00, 0xfa, 0x25, 0x25, 0x26, 0xf9, 0x00, 0x00, // Ã
+    0x7e, 0x41, 0x41, 0xc1, 0x41, 0x41, 0x41, 0x00, // Ç
+    0x00, 0xfc, 0x94, 0x96, 0x95, 0x84, 0x00, 0x00, // É
+    0x00, 0xfc, 0x96, 0x95, 0x96, 0x84, 0x00, 0x00, // Ê
+    0x00, 0x00, 0x84, 0xfe, 0x85, 0x00, 0x00, 0x00, // Í
+    0x00, 0x78, 0x84, 0x86, 0x85, 0x78, 0x00, 0x00, // Ó
+    0x00, 0x78, 0x86, 0x85, 0x86, 0x78, 0x00, 0x00, // Ô
+    0x00, 0x7a, 0x85, 0x85, 0x86, 0x79, 0x00, 0x00, // Õ
+    0x00, 0x7c, 0x80, 0x82, 0x81, 0x7c, 0x00, 0x00, // Ú
+    0x00, 0x7c, 0x81, 0x80, 0x81, 0x7c, 0x00, 0x00, // Ü
+    0x00, 0x20, 0x55, 0x56, 0x54, 0x78, 0x00, 0x00, // à
+    0x00, 0x20, 0x54, 0x56, 0x55, 0x78, 0x00, 0x00, // á
+    0x00, 0x20, 0x56, 0x55, 0x56, 0x78, 0x00, 0x00, // â
+    0x00, 0x22, 0x55, 0x55, 0x56, 0x79, 0x00, 0x00, // ã
+    0x00, 0x38, 0x44, 0xc4, 0x44, 0x20, 0x00, 0x00, // ç
+    0x00, 0x38, 0x54, 0x56, 0x55, 0x18, 0x00, 0x00, // é
+    0x00, 0x38, 0x56, 0x55, 0x56, 0x18, 0x00, 0x00, // ê
+    0x00, 0x00, 0x44, 0x7e, 0x41, 0x00, 0x00, 0x00, // í
+    0x00, 0x38, 0x44, 0x46, 0x45, 0x38, 0x00, 0x00, // ó
+    0x00, 0x38, 0x46, 0x45, 0x46, 0x38, 0x00, 0x00, // ô
+    0x00, 0x3a, 0x45, 0x45, 0x46, 0x39, 0x00, 0x00, // õ
+    0x00, 0x3c, 0x40, 0x42, 0x21, 0x7c, 0x00, 0x00, // ú
+    0x00, 0x3c, 0x41, 0x40, 0x21, 0x7c, 0x00, 0x00, // ü
+};
+
+// Código Latin-1 -> glifo em font[] (0: sem glifo, desenhado em branco)
+static const uint8_t font_index[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,
+     17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,
+     33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+     49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,
+     65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,
+     81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  95,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  96,   0,   0,   0,   0,   0,
+     97,   0,   0,   0,   0,   0,   0,   0,   0,   0,  98,   0,   0,   0,   0,   0,
+     99, 100, 101, 102,   0,   0,   0, 103,   0, 104, 105,   0,   0, 106,   0,   0,
+      0,   0,   0, 107, 108, 109,   0,   0,   0,   0, 110,   0, 111,   0,   0,   0,
+    112, 113, 114, 115,   0,   0,   0, 116,   0, 117, 118,   0,   0, 119,   0,   0,
+      0,   0,   0, 120, 121, 122,   0,   0,   0,   0, 123,   0, 124,   0,   0,   0,
+};
+
+// Fonte proporcional: primeira coluna acesa (4 bits altos) e largura (4 bits baixos) de cada glifo
+static const uint8_t font_metrics[] = {
+    0x03, 0x03, 0x31, 0x23, 0x15, 0x15, 0x15, 0x15, 0x22, 0x23, 0x23, 0x15,
+    0x15, 0x22, 0x15, 0x22, 0x15, 0x07, 0x23, 0x06, 0x07, 0x06, 0x06, 0x07,
+    0x07, 0x07, 0x07, 0x22, 0x22, 0x14, 0x15, 0x24, 0x15, 0x15, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x31, 0x07, 0x16, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x06, 0x07, 0x07, 0x07, 0x07, 0x16, 0x07, 0x06,
+    0x23, 0x15, 0x23, 0x15, 0x15, 0x23, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x23, 0x14, 0x14, 0x23, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x23, 0x31, 0x23, 0x15,
+    0x14, 0x24, 0x14, 0x15, 0x15, 0x15, 0x15, 0x07, 0x15, 0x15, 0x23, 0x15,
+    0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x23,
+    0x15, 0x15, 0x15, 0x15, 0x15,
+};
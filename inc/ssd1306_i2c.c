@@ -5,41 +5,175 @@
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
+#include "i2c_bus.h"
+
+// Framebuffers duplos: desenha-se no de trás enquanto o da frente guarda o conteúdo do display.
+// O byte 0 de cada um é reservado para o byte de controle 0x40, como em ssd1306_t.ram_buffer
+static uint8_t framebuffers[2][ssd1306_buffer_length + 1];
+static uint8_t back_index = 0;
+static bool front_valid = false;
+
+// Fluxo enviado pelo DMA ao registrador IC_DATA_CMD (um byte por palavra, STOP na última).
+// Cada área alterada leva seu próprio preâmbulo, separado da anterior por um RESTART
+static uint16_t dma_stream[ssd1306_buffer_length + ssd1306_n_pages * ssd1306_preamble_length];
+static int dma_channel = -1;
+static volatile bool dma_busy = false;
+static bool flush_pending = false;      // o resultado do último envio pelo DMA ainda não foi conferido
+static uint64_t flush_deadline_us;
+static bool panel_ready = false;        // comandos de inicialização aceitos pelo display
+static ssd1306_flush_callback_t flush_callback = NULL;
+static void *flush_callback_ctx = NULL;
+
+static uint8_t send_buffer[ssd1306_buffer_length + ssd1306_preamble_length];
+static struct ssd1306_flush_stats flush_stats;
 
 // Calcular quanto do buffer será destinado à área de renderização
 void calculate_render_area_buffer_length(struct render_area *area) {
     area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
 }
 
+// Indica se ainda há um quadro sendo enviado (pelo DMA ou pela FIFO do i2c)
+bool ssd1306_flush_busy() {
+    return dma_busy || i2c_bus_busy();
+}
+
+// Envio preso além do prazo (escravo segurando o barramento): para o DMA sem gerar a
+// interrupção de fim e recupera o barramento
+static void ssd1306_flush_abort() {
+    dma_channel_set_irq0_enabled(dma_channel, false);
+    dma_channel_abort(dma_channel);
+    dma_channel_acknowledge_irq0(dma_channel);
+    dma_channel_set_irq0_enabled(dma_channel, true);
+    dma_busy = false;
+    i2c_bus_fail(PICO_ERROR_TIMEOUT);
+}
+
+// Aguarda o fim do envio em andamento, no máximo até o prazo dele; o i2c não pode ser
+// reconfigurado no meio de uma transferência. Retorna false se o envio falhou: o conteúdo do
+// display fica incerto, então o próximo quadro vai inteiro, depois da inicialização
+bool ssd1306_flush_wait() {
+    int result = PICO_OK;
+    while (ssd1306_flush_busy()) {
+        if (flush_pending && time_us_64() > flush_deadline_us) {
+            ssd1306_flush_abort();
+            result = PICO_ERROR_TIMEOUT;
+            break;
+        }
+        tight_loop_contents();
+    }
+
+    if (!flush_pending) {
+        return true;
+    }
+    flush_pending = false;
+    if (result == PICO_OK) {
+        result = i2c_bus_check();
+        if (result == PICO_OK) {
+            i2c_bus_ok();
+        } else {
+            i2c_bus_fail(result);
+        }
+    }
+    if (result != PICO_OK) {
+        front_valid = false;
+        panel_ready = false;
+    }
+    return result == PICO_OK;
+}
+
+// Toda escrita bloqueante passa por aqui; no barramento do display, pelo transporte, com prazo e recuperação
+static bool ssd1306_write(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t length, bool nostop) {
+    if (i2c == i2c_bus_inst()) {
+        ssd1306_flush_wait();
+        return i2c_bus_write(address, data, length, nostop) == (int)length;
+    }
+    return i2c_write_blocking(i2c, address, data, length, nostop) == (int)length;
+}
+
+// Escreve o preâmbulo que endereça a área; cada comando vai precedido de um byte de controle com Co=1,
+// de modo que os dados (após o 0x40) seguem na mesma transação
+static int ssd1306_area_preamble(uint8_t *out, const struct render_area *area) {
+    const uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+
+    for (int i = 0; i < count_of(commands); i++) {
+        *out++ = ssd1306_control_command;
+        *out++ = commands[i];
+    }
+    *out = ssd1306_control_data_stream;
+    return ssd1306_preamble_length;
+}
+
 // Processo de escrita do i2c espera um byte de controle, seguido por dados
-void ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+bool ssd1306_send_command(uint8_t command) {
+    uint8_t buffer[2] = {ssd1306_control_command, command};
+    return ssd1306_write(i2c_bus_inst(), ssd1306_i2c_address, buffer, 2, false);
+}
+
+// Envia uma sequência de comandos numa única transação, precedida do byte de controle 0x00
+bool ssd1306_send_command_stream(const uint8_t *commands, int number) {
+    assert(number < sizeof send_buffer);
+
+    send_buffer[0] = ssd1306_control_command_stream;
+    memcpy(send_buffer + 1, commands, number);
+    return ssd1306_write(i2c_bus_inst(), ssd1306_i2c_address, send_buffer, number + 1, false);
 }
 
 // Envia uma lista de comandos ao hardware
-void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
-    }
+bool ssd1306_send_command_list(uint8_t *ssd, int number) {
+    return ssd1306_send_command_stream(ssd, number);
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
+// Copia buffer de referência num buffer estático, a fim de adicionar o byte de controle desde o início
+bool ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
+    send_buffer[0] = ssd1306_control_data_stream;
+    memcpy(send_buffer + 1, ssd, buffer_length);
 
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
+    return ssd1306_write(i2c_bus_inst(), ssd1306_i2c_address, send_buffer, buffer_length + 1, false);
+}
+
+// Fim da transferência do DMA: o restante do quadro já está na FIFO do i2c
+static void ssd1306_dma_irq_handler() {
+    if (dma_channel < 0 || !dma_channel_get_irq0_status(dma_channel)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0(dma_channel);
+    dma_busy = false;
 
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
+    if (flush_callback) {
+        flush_callback(flush_callback_ctx);
+    }
+}
 
-    free(temp_buffer);
+// Reserva o canal de DMA que alimenta a FIFO de transmissão do i2c
+static void ssd1306_dma_init() {
+    if (dma_channel >= 0) {
+        return;
+    }
+    dma_channel = dma_claim_unused_channel(true);
+
+    // Escritas estreitas no barramento APB são replicadas, por isso cada byte vai numa palavra de 16 bits
+    dma_channel_config config = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c_bus_inst(), true));
+    dma_channel_configure(dma_channel, &config, &i2c_get_hw(i2c_bus_inst())->data_cmd, dma_stream, 0, false);
+
+    // A DMA_IRQ_0 fica habilitada só no núcleo que chama esta função, o da tarefa do display
+    dma_channel_set_irq0_enabled(dma_channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
 }
 
 // Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init() {
+static bool ssd1306_init_panel() {
     uint8_t commands[] = {
         ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
         ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
@@ -61,153 +195,544 @@ void ssd1306_init() {
         ssd1306_set_display | 0x01,
     };
 
-    ssd1306_send_command_list(commands, count_of(commands));
+    front_valid = false;
+    panel_ready = ssd1306_send_command_list(commands, count_of(commands));
+    return panel_ready;
+}
+
+// Inicializa o display no barramento já configurado por i2c_bus_init. Sem resposta do display,
+// a inicialização é repetida antes de cada quadro, até ele aparecer
+bool ssd1306_init() {
+    framebuffers[0][0] = 0x40;
+    framebuffers[1][0] = 0x40;
+    ssd1306_dma_init();
+    return ssd1306_init_panel();
 }
 
 // Cria a lista de comandos para configurar o scrolling
-void ssd1306_scroll(bool set) {
+bool ssd1306_scroll(bool set) {
     uint8_t commands[] = {
         ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
         0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
     };
 
-    ssd1306_send_command_list(commands, count_of(commands));
+    return ssd1306_send_command_list(commands, count_of(commands));
 }
 
-// Atualiza uma parte do display com uma área de renderização
-void render_on_display(uint8_t *ssd, struct render_area *area) {
-    uint8_t commands[] = {
-        ssd1306_set_column_address, area->start_column, area->end_column,
-        ssd1306_set_page_address, area->start_page, area->end_page
-    };
+// Atualiza uma parte do display com uma área de renderização, numa única transação
+bool render_on_display(uint8_t *ssd, struct render_area *area) {
+    int length = ssd1306_area_preamble(send_buffer, area);
+    memcpy(send_buffer + length, ssd, area->buffer_length);
+
+    return ssd1306_write(i2c_bus_inst(), ssd1306_i2c_address, send_buffer, length + area->buffer_length, false);
+}
+
+// Registra a função chamada (no contexto da interrupção do DMA) ao fim de cada envio
+void ssd1306_set_flush_callback(ssd1306_flush_callback_t callback, void *ctx) {
+    flush_callback = callback;
+    flush_callback_ctx = ctx;
+}
+
+// Retorna o framebuffer de trás, onde o próximo quadro deve ser desenhado
+uint8_t *ssd1306_draw_buffer() {
+    return framebuffers[back_index] + 1;
+}
+
+// Invalida a cópia do display, forçando o envio completo no próximo flush
+void ssd1306_invalidate() {
+    front_valid = false;
+}
+
+// Envia ao display, via DMA, as regiões do framebuffer de trás que mudaram desde o último envio.
+// Retorna false se não havia nada a enviar (e nenhuma notificação de fim será gerada)
+bool ssd1306_flush_async() {
+    const uint8_t *back = framebuffers[back_index] + 1;
+    const uint8_t *front = framebuffers[back_index ^ 1] + 1;
+    uint8_t first[ssd1306_n_pages];
+    uint8_t last[ssd1306_n_pages];
+    bool dirty[ssd1306_n_pages];
+    bool diffed = front_valid;
+
+    // Procura, em cada página, a primeira e a última coluna diferentes do framebuffer da frente
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        const uint8_t *row = back + page * ssd1306_width;
+        const uint8_t *old = front + page * ssd1306_width;
+        int start = 0;
+        int end = ssd1306_width - 1;
+
+        if (front_valid) {
+            while (start <= end && row[start] == old[start]) start++;
+            while (end >= start && row[end] == old[end]) end--;
+        }
+
+        dirty[page] = start <= end;
+        first[page] = start;
+        last[page] = end;
+    }
+
+    // O fluxo do DMA só pode ser reescrito depois que o envio anterior terminar. Com o barramento
+    // parado, aplica a frequência pedida e, se o display não respondeu, tenta inicializá-lo de novo
+    ssd1306_flush_wait();
+    i2c_bus_apply();
+    if (!panel_ready && !ssd1306_init_panel()) {
+        return false;
+    }
+
+    // O envio anterior falhou depois da comparação: o quadro vai inteiro
+    if (diffed && !front_valid) {
+        for (int page = 0; page < ssd1306_n_pages; page++) {
+            dirty[page] = true;
+            first[page] = 0;
+            last[page] = ssd1306_width - 1;
+        }
+    }
+
+    int sent = 0;
+    int runs = 0;
+    uint16_t *out = dma_stream;
+    int page = 0;
+    while (page < ssd1306_n_pages) {
+        if (!dirty[page]) {
+            page++;
+            continue;
+        }
 
-    ssd1306_send_command_list(commands, count_of(commands));
-    ssd1306_send_buffer(ssd, area->buffer_length);
+        // Agrupa páginas sujas consecutivas numa única área, com a união das colunas
+        struct render_area area = {first[page], last[page], page, page};
+        while (area.end_page + 1 < ssd1306_n_pages && dirty[area.end_page + 1]) {
+            area.end_page++;
+            if (first[area.end_page] < area.start_column) area.start_column = first[area.end_page];
+            if (last[area.end_page] > area.end_column) area.end_column = last[area.end_page];
+        }
+        calculate_render_area_buffer_length(&area);
+
+        // Preâmbulo e dados da área, na ordem em que o display os recebe; a partir da segunda área, RESTART
+        uint8_t preamble[ssd1306_preamble_length];
+        ssd1306_area_preamble(preamble, &area);
+        for (int i = 0; i < ssd1306_preamble_length; i++) {
+            *out++ = preamble[i];
+        }
+        if (runs > 0) {
+            out[-ssd1306_preamble_length] |= I2C_IC_DATA_CMD_RESTART_BITS;
+        }
+
+        int width = area.end_column - area.start_column + 1;
+        for (int p = area.start_page; p <= area.end_page; p++) {
+            const uint8_t *src = back + p * ssd1306_width + area.start_column;
+            for (int c = 0; c < width; c++) {
+                *out++ = src[c];
+            }
+        }
+
+        sent += area.buffer_length;
+        runs++;
+        page = area.end_page + 1;
+    }
+
+    flush_stats.frames++;
+    flush_stats.bytes_saved += ssd1306_buffer_length - sent;
+    if (runs == 0) {
+        return false;
+    }
+    out[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    // O endereço de destino só pode ser trocado com o i2c desabilitado
+    i2c_hw_t *hw = i2c_get_hw(i2c_bus_inst());
+    hw->enable = 0;
+    hw->tar = ssd1306_i2c_address;
+    hw->enable = 1;
+
+    // Cada área é uma transação, com o byte de endereço
+    uint32_t bytes = (out - dma_stream) + runs;
+    flush_deadline_us = time_us_64() + i2c_bus_timeout_us(bytes);
+    flush_pending = true;
+    dma_busy = true;
+    dma_channel_transfer_from_buffer_now(dma_channel, dma_stream, out - dma_stream);
+
+    // O quadro enviado passa a ser o da frente; o de trás parte do mesmo conteúdo
+    back_index ^= 1;
+    memcpy(framebuffers[back_index] + 1, back, ssd1306_buffer_length);
+    front_valid = true;
+
+    flush_stats.bytes_sent += sent;
+    i2c_bus_account(runs, bytes);
+    return true;
+}
+
+// Copia o buffer fornecido para o framebuffer de trás e o envia, aguardando o fim da transferência
+void ssd1306_flush(uint8_t *ssd) {
+    memcpy(ssd1306_draw_buffer(), ssd, ssd1306_buffer_length);
+    ssd1306_flush_async();
+    ssd1306_flush_wait();
+}
+
+// Retorna os contadores de envio do flush parcial; os do barramento estão em i2c_bus_get_stats
+const struct ssd1306_flush_stats *ssd1306_get_flush_stats() {
+    return &flush_stats;
 }
 
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
 void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
 
-    const int bytes_per_row = ssd1306_width;
-
-    int byte_idx = (y / 8) * bytes_per_row + x;
-    uint8_t byte = ssd[byte_idx];
+    uint8_t *byte = ssd + (y >> 3) * ssd1306_width + x;
+    uint8_t bit = 1 << (y & 7);
 
     if (set) {
-        byte |= 1 << (y % 8);
+        *byte |= bit;
     }
     else {
-        byte &= ~(1 << (y % 8));
+        *byte &= ~bit;
+    }
+}
+
+// === Rasterização por bytes de página ===
+// Cada byte do framebuffer é uma coluna de 8 linhas de uma página. As primitivas abaixo
+// calculam, para cada página tocada, a máscara das linhas cobertas e a aplicam à faixa de
+// colunas de uma vez, em palavras de 32 bits (4 colunas) no trecho alinhado da faixa.
+
+// Palavra que pode apelidar o framebuffer de bytes sem violar a regra de aliasing
+typedef uint32_t __attribute__((may_alias)) ssd1306_word_t;
+
+// Máscara das linhas y_0..y_1 (já recortadas) dentro da página "page"
+static inline uint8_t ssd1306_page_mask(int page, int y_0, int y_1) {
+    int top = y_0 > page * 8 ? y_0 - page * 8 : 0;
+    int bottom = y_1 < page * 8 + 7 ? y_1 - page * 8 : 7;
+    return (0xFF << top) & (0xFF >> (7 - bottom));
+}
+
+// Aplica a máscara a "n" colunas seguidas: liga, desliga ou inverte os bits
+static void ssd1306_span(uint8_t *p, int n, uint8_t mask, enum ssd1306_op op) {
+    if (mask == 0xFF && op != SSD1306_XOR) {
+        memset(p, op == SSD1306_SET ? 0xFF : 0x00, n);
+        return;
+    }
+
+    // Bytes até o alinhamento de 4, palavras inteiras e o resto
+    while (n > 0 && ((uintptr_t)p & 3)) {
+        *p = op == SSD1306_SET ? *p | mask : op == SSD1306_CLEAR ? *p & ~mask : *p ^ mask;
+        p++;
+        n--;
+    }
+
+    uint32_t wmask = mask * 0x01010101u;
+    ssd1306_word_t *w = (ssd1306_word_t *)p;
+    if (op == SSD1306_SET) {
+        for (; n >= 4; n -= 4) *w++ |= wmask;
+    } else if (op == SSD1306_CLEAR) {
+        for (; n >= 4; n -= 4) *w++ &= ~wmask;
+    } else {
+        for (; n >= 4; n -= 4) *w++ ^= wmask;
+    }
+
+    p = (uint8_t *)w;
+    while (n-- > 0) {
+        *p = op == SSD1306_SET ? *p | mask : op == SSD1306_CLEAR ? *p & ~mask : *p ^ mask;
+        p++;
+    }
+}
+
+// Recorta o retângulo ao display; retorna false se não sobrou nada
+static bool ssd1306_clip(int *x, int *y, int *w, int *h) {
+    if (*x < 0) { *w += *x; *x = 0; }
+    if (*y < 0) { *h += *y; *y = 0; }
+    if (*x + *w > ssd1306_width) *w = ssd1306_width - *x;
+    if (*y + *h > ssd1306_height) *h = ssd1306_height - *y;
+    return *w > 0 && *h > 0;
+}
+
+// Aplica a operação ao retângulo, página por página
+void ssd1306_rect_op(uint8_t *ssd, int x, int y, int w, int h, enum ssd1306_op op) {
+    if (!ssd1306_clip(&x, &y, &w, &h)) {
+        return;
+    }
+
+    int y_end = y + h - 1;
+    for (int page = y >> 3; page <= y_end >> 3; page++) {
+        ssd1306_span(ssd + page * ssd1306_width + x, w, ssd1306_page_mask(page, y, y_end), op);
+    }
+}
+
+void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int w, int h, bool set) {
+    ssd1306_rect_op(ssd, x, y, w, h, set ? SSD1306_SET : SSD1306_CLEAR);
+}
+
+// Inverte os pixels do retângulo (barra de seleção, destaque)
+void ssd1306_invert_rect(uint8_t *ssd, int x, int y, int w, int h) {
+    ssd1306_rect_op(ssd, x, y, w, h, SSD1306_XOR);
+}
+
+// Linha horizontal de x_0 a x_1 (inclusive): uma máscara de um bit numa página
+void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, bool set) {
+    if (x_0 > x_1) {
+        int t = x_0; x_0 = x_1; x_1 = t;
+    }
+    ssd1306_fill_rect(ssd, x_0, y, x_1 - x_0 + 1, 1, set);
+}
+
+// Linha vertical de y_0 a y_1 (inclusive): um byte por página
+void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, bool set) {
+    if (y_0 > y_1) {
+        int t = y_0; y_0 = y_1; y_1 = t;
+    }
+    ssd1306_fill_rect(ssd, x, y_0, 1, y_1 - y_0 + 1, set);
+}
+
+// Contorno de um retângulo com 1 pixel de espessura
+void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int w, int h, bool set) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    ssd1306_fill_rect(ssd, x, y, w, 1, set);
+    ssd1306_fill_rect(ssd, x, y + h - 1, w, 1, set);
+    ssd1306_fill_rect(ssd, x, y, 1, h, set);
+    ssd1306_fill_rect(ssd, x + w - 1, y, 1, h, set);
+}
+
+// Copia um bitmap no formato do framebuffer (w colunas, (h + 7) / 8 páginas) para (x, y),
+// substituindo só as linhas cobertas; fora do múltiplo de 8, cada página de destino junta
+// os bits de duas páginas de origem
+void ssd1306_blit(uint8_t *ssd, int x, int y, const uint8_t *bitmap, int w, int h) {
+    int cx = x, cy = y, cw = w, ch = h;
+    if (!ssd1306_clip(&cx, &cy, &cw, &ch)) {
+        return;
     }
 
-    ssd[byte_idx] = byte;
+    int pages = (h + 7) >> 3;
+    int y_end = cy + ch - 1;
+    const uint8_t *src = bitmap + (cx - x);
+
+    for (int page = cy >> 3; page <= y_end >> 3; page++) {
+        int row = page * 8 - y;     // linha da origem que cai no bit 0 desta página
+        int sp = row >> 3;          // arredonda para baixo também se row < 0
+        int off = row & 7;
+        const uint8_t *a = sp >= 0 && sp < pages ? src + sp * w : NULL;
+        const uint8_t *b = off && sp + 1 >= 0 && sp + 1 < pages ? src + (sp + 1) * w : NULL;
+        uint8_t mask = ssd1306_page_mask(page, cy, y_end);
+        uint8_t *dst = ssd + page * ssd1306_width + cx;
+
+        for (int c = 0; c < cw; c++) {
+            uint8_t bits = (a ? a[c] >> off : 0) | (b ? b[c] << (8 - off) : 0);
+            dst[c] = (dst[c] & ~mask) | (bits & mask);
+        }
+    }
 }
 
-// Algoritmo de Bresenham básico
+// Algoritmo de Bresenham sobre o byte e o bit correntes: sem divisão nem assert por pixel.
+// Linhas horizontais e verticais vão direto para as primitivas de faixa
 void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
+    assert(x_0 >= 0 && x_0 < ssd1306_width && y_0 >= 0 && y_0 < ssd1306_height);
+    assert(x_1 >= 0 && x_1 < ssd1306_width && y_1 >= 0 && y_1 < ssd1306_height);
+
+    if (y_0 == y_1) {
+        ssd1306_draw_hline(ssd, x_0, x_1, y_0, set);
+        return;
+    }
+    if (x_0 == x_1) {
+        ssd1306_draw_vline(ssd, x_0, y_0, y_1, set);
+        return;
+    }
+
     int dx = abs(x_1 - x_0); // Deslocamentos
     int dy = -abs(y_1 - y_0);
     int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
     int sy = y_0 < y_1 ? 1 : -1;
     int error = dx + dy; // Erro acumulado
-    int error_2;
+    int steps = dx > -dy ? dx : -dy;
 
-    while (true) {
-        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
-        if (x_0 == x_1 && y_0 == y_1) {
-            break; // Verifica se o ponto final foi alcançado
-        }
+    uint8_t *p = ssd + (y_0 >> 3) * ssd1306_width + x_0;
+    uint8_t bit = 1 << (y_0 & 7);
 
-        error_2 = 2 * error; // Ajusta o erro acumulado
+    for (int i = 0; i <= steps; i++) {
+        if (set) *p |= bit;
+        else *p &= ~bit;
 
+        int error_2 = 2 * error; // Ajusta o erro acumulado
         if (error_2 >= dy) {
             error += dy;
-            x_0 += sx; // Avança na direção x
+            p += sx; // Avança na direção x
         }
         if (error_2 <= dx) {
             error += dx;
-            y_0 += sy; // Avança na direção y
+            // Avança na direção y, passando para a página vizinha quando o bit sai do byte
+            if (sy > 0) {
+                bit <<= 1;
+                if (!bit) { bit = 0x01; p += ssd1306_width; }
+            } else {
+                bit >>= 1;
+                if (!bit) { bit = 0x80; p -= ssd1306_width; }
+            }
         }
     }
 }
 
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  }
-  else
-    return 0;
+// === Texto ===
+// Os glifos (ssd1306_font.h) são achados por uma tabela direta de 256 posições indexada pelo
+// código Latin-1; o texto pode vir em Latin-1 ou em UTF-8 (os acentos do português ocupam
+// dois bytes, C2/C3 mais um de continuação). Com y fora do múltiplo de 8, cada coluna do
+// glifo é dividida entre duas páginas, substituindo só as 8 linhas da célula.
+const ssd1306_font_t ssd1306_font_fixed = {.advance = 8, .proportional = false};
+const ssd1306_font_t ssd1306_font_proportional = {.advance = 1, .proportional = true};
+static const ssd1306_font_t *current_font = &ssd1306_font_fixed;
+
+// Fonte usada por ssd1306_draw_char e ssd1306_draw_string
+void ssd1306_set_font(const ssd1306_font_t *f) {
+    current_font = f;
 }
 
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+// Próximo caractere do texto, em Latin-1
+static inline uint8_t ssd1306_next_char(const uint8_t **s) {
+    uint8_t c = *(*s)++;
+    if ((c & 0xFE) == 0xC2 && (**s & 0xC0) == 0x80) {
+        c = (c & 0x03) << 6 | (*(*s)++ & 0x3F);
+    }
+    return c;
+}
+
+// Copia "w" colunas do glifo para (x, y), recortando no display
+static void ssd1306_put_glyph(uint8_t *ssd, int x, int y, const uint8_t *glyph, int w) {
+    if (x < 0) {
+        glyph -= x;
+        w += x;
+        x = 0;
+    }
+    if (x + w > ssd1306_width) {
+        w = ssd1306_width - x;
+    }
+    if (w <= 0 || y <= -8 || y >= ssd1306_height) {
         return;
     }
 
-    y = y / 8;
+    int page = y >> 3;
+    int shift = y & 7;
+    uint8_t *dst = ssd + page * ssd1306_width + x;
 
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
+    // Alinhado à página: o glifo é copiado direto
+    if (shift == 0) {
+        memcpy(dst, glyph, w);
+        return;
+    }
+
+    if (page >= 0) {
+        uint8_t keep = 0xFF >> (8 - shift);
+        for (int c = 0; c < w; c++) {
+            dst[c] = (dst[c] & keep) | glyph[c] << shift;
+        }
+    }
+    if (page + 1 < ssd1306_n_pages) {
+        uint8_t keep = 0xFF << shift;
+        dst += ssd1306_width;
+        for (int c = 0; c < w; c++) {
+            dst[c] = (dst[c] & keep) | glyph[c] >> (8 - shift);
+        }
+    }
+}
 
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
+// Desenha o caractere na fonte atual e retorna quantas colunas o texto avança
+static int ssd1306_draw_glyph(uint8_t *ssd, int x, int y, uint8_t character) {
+    const uint8_t *glyph = font + font_index[character] * 8;
+
+    if (!current_font->proportional) {
+        ssd1306_put_glyph(ssd, x, y, glyph, 8);
+        return current_font->advance;
     }
+
+    uint8_t m = font_metrics[font_index[character]];
+    ssd1306_put_glyph(ssd, x, y, glyph + (m >> 4), m & 0x0F);
+    return (m & 0x0F) + current_font->advance;
 }
 
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
+// Desenha um único caractere (código Latin-1) no display, em qualquer posição
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    ssd1306_draw_glyph(ssd, x, y, character);
+}
+
+// Desenha uma string, caractere por caractere, até o fim do texto ou da largura do display.
+// Na fonte fixa com a linha inteira dentro do display, a página, o deslocamento e as máscaras
+// são calculados uma vez para a string toda
 void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
+    const uint8_t *s = (const uint8_t *)string;
+    int cx = x;
+
+    if (!current_font->proportional && x >= 0 && y >= 0 && y <= ssd1306_height - 8) {
+        int shift = y & 7;
+        uint8_t keep = 0xFF >> (8 - shift);
+        uint8_t *row = ssd + (y >> 3) * ssd1306_width;
+
+        while (*s && cx <= ssd1306_width - 8) {
+            const uint8_t *glyph = font + font_index[ssd1306_next_char(&s)] * 8;
+            uint8_t *dst = row + cx;
+
+            if (shift == 0) {
+                memcpy(dst, glyph, 8);
+            } else {
+                for (int c = 0; c < 8; c++) {
+                    uint16_t bits = glyph[c] << shift;
+                    dst[c] = (dst[c] & keep) | (uint8_t)bits;
+                    dst[c + ssd1306_width] = (dst[c + ssd1306_width] & ~keep) | bits >> 8;
+                }
+            }
+            cx += current_font->advance;
+        }
     }
 
-    while (*string) {
-        ssd1306_draw_char(ssd, x, y, *string++);
-        x += 8;
+    // Fonte proporcional, posições recortadas e o último caractere parcial
+    while (*s && cx < ssd1306_width) {
+        cx += ssd1306_draw_glyph(ssd, cx, y, ssd1306_next_char(&s));
     }
 }
 
+// Largura, em colunas, que a string ocupa na fonte atual
+int ssd1306_string_width(const char *string) {
+    const uint8_t *s = (const uint8_t *)string;
+    int width = 0;
+
+    while (*s) {
+        uint8_t c = ssd1306_next_char(&s);
+        width += current_font->proportional ? (font_metrics[font_index[c]] & 0x0F) + current_font->advance
+                                            : current_font->advance;
+    }
+    return current_font->proportional && width ? width - current_font->advance : width;
+}
+
 // Comando de configuração com base na estrutura ssd1306_t
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
+  ssd1306_write(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+}
+
+// Sequência de comandos numa única transação, com base na estrutura ssd1306_t
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number, bool nostop) {
+    uint8_t buffer[32];
+    assert(number < sizeof buffer);
+
+    buffer[0] = ssd1306_control_command_stream;
+    memcpy(buffer + 1, commands, number);
+    ssd1306_write(ssd->i2c_port, ssd->address, buffer, number + 1, nostop);
 }
 
 // Função de configuração do display para o caso do bitmap
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
+    const uint8_t commands[] = {
+        ssd1306_set_display | 0x00,
+        ssd1306_set_memory_mode, 0x01,
+        ssd1306_set_display_start_line | 0x00,
+        ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio, ssd1306_height - 1,
+        ssd1306_set_common_output_direction | 0x08,
+        ssd1306_set_display_offset, 0x00,
+        ssd1306_set_common_pin_configuration, 0x12,
+        ssd1306_set_display_clock_divide_ratio, 0x80,
+        ssd1306_set_precharge, 0xF1,
+        ssd1306_set_vcomh_deselect_level, 0x30,
+        ssd1306_set_contrast, 0xFF,
+        ssd1306_set_entire_on,
+        ssd1306_set_normal_display,
+        ssd1306_set_charge_pump, 0x14,
+        ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands), false);
 }
 
 // Inicializa o display para o caso de exibição de bitmap
@@ -223,23 +748,22 @@ void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool externa
     ssd->port_buffer[0] = 0x80;
 }
 
-// Envia os dados ao display
+// Envia os dados ao display: o endereçamento e os dados saem separados só por um RESTART, com um único STOP
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-    ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
+    const uint8_t commands[] = {
+        ssd1306_set_column_address, 0, ssd->width - 1,
+        ssd1306_set_page_address, 0, ssd->pages - 1
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands), true);
+    ssd1306_write(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
 }
 
 // Desenha o bitmap (a ser fornecido em display_oled.c) no display
 void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
     for (int i = 0; i < ssd->bufsize - 1; i++) {
         ssd->ram_buffer[i + 1] = bitmap[i];
-
-        ssd1306_send_data(ssd);
     }
+
+    ssd1306_send_data(ssd);
 }
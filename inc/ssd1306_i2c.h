@@ -10,7 +10,9 @@
 
 #define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
 
-#define ssd1306_i2c_clock 400 // Define o tempo do clock (pode ser aumentado)
+// Clock do i2c em kHz. 1000 (Fast-mode Plus) passa da especificação do SSD1306, mas a maioria dos
+// módulos aceita; o transporte desce para 400 kHz se o barramento falhar seguidamente
+#define ssd1306_i2c_clock 400
 
 // Comandos de configuração (endereços)
 #define ssd1306_set_memory_mode _u(0x20)
@@ -44,6 +46,14 @@
 #define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
 #define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
 
+// Bytes de controle: um comando (Co=1), sequência de comandos e sequência de dados
+#define ssd1306_control_command _u(0x80)
+#define ssd1306_control_command_stream _u(0x00)
+#define ssd1306_control_data_stream _u(0x40)
+
+// Tamanho do preâmbulo de endereçamento de área (6 comandos com Co=1 mais o 0x40 dos dados)
+#define ssd1306_preamble_length 13
+
 #define ssd1306_write_mode _u(0xFE)
 #define ssd1306_read_mode _u(0xFF)
 
@@ -56,6 +66,30 @@ struct render_area {
     int buffer_length;
 };
 
+// Contadores do flush parcial (bytes de pixel); os do barramento ficam no transporte (i2c_bus.h)
+struct ssd1306_flush_stats {
+    uint32_t frames;
+    uint32_t bytes_sent;
+    uint32_t bytes_saved;
+};
+
+// Operações das primitivas de faixa (retângulos, linhas retas, inversão)
+enum ssd1306_op {
+    SSD1306_SET,
+    SSD1306_CLEAR,
+    SSD1306_XOR
+};
+
+// Fonte do texto: células fixas de "advance" colunas, ou (proporcional) a largura de cada
+// glifo mais "advance" colunas de espaço
+typedef struct {
+    uint8_t advance;
+    bool proportional;
+} ssd1306_font_t;
+
+// Função chamada ao fim do envio de um quadro pelo DMA (em contexto de interrupção)
+typedef void (*ssd1306_flush_callback_t)(void *ctx);
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t * i2c_port;
@@ -42,7 +42,13 @@
 
 /* Scheduler Related */
 #define configUSE_PREEMPTION                    1
+#if PROJETO_SMP
+/* O FreeRTOS SMP não tem tickless idle: com os dois núcleos, o sono de src/power.c fica desligado */
 #define configUSE_TICKLESS_IDLE                 0
+#else
+#define configUSE_TICKLESS_IDLE                 2
+#endif
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   5
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
@@ -70,21 +76,51 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0
+/* Tarefas, filas e timers do projeto são estáticos (src/main.c); o heap fica só para o que o
+   SDK cria por conta própria, como a tarefa que trava o outro núcleo durante a gravação da flash */
+#define configSUPPORT_STATIC_ALLOCATION         1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   (128*1024)
+#define configTOTAL_HEAP_SIZE                   (4*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
+/* Confere o ponteiro e a marca no fim da pilha a cada troca de contexto: as pilhas são estimadas
+   (README) com pouca folga, e um estouro vira vApplicationStackOverflowHook em vez de memória corrompida */
+#define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+extern uint64_t diag_run_time_us( void );
+extern void diag_queue_level( unsigned long uxQueueNumber, unsigned long uxWaiting );
+extern void trace_task_switched_in( unsigned long uxTaskNumber );
+extern void trace_queue( unsigned long xSend, unsigned long ucQueueType, unsigned long uxQueueNumber, unsigned long uxWaiting );
+#endif
+
+/* Timer de 1 MHz do RP2040, já rodando desde o boot */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        diag_run_time_us()
+
+/* Pico de ocupação (src/diag.c) e eventos do trace (src/trace.c) das filas e mutexes
+   registrados com diag_add_queue (uxQueueNumber != 0) e troca de tarefa */
+#define traceQUEUE_SEND( pxQueue ) \
+    do { if( ( pxQueue )->uxQueueNumber != 0 ) { \
+        diag_queue_level( ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting + 1 ); \
+        trace_queue( 1, ( pxQueue )->ucQueueType, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting + 1 ); } } while( 0 )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )     traceQUEUE_SEND( pxQueue )
+#define traceQUEUE_RECEIVE( pxQueue ) \
+    do { if( ( pxQueue )->uxQueueNumber != 0 ) \
+        trace_queue( 0, ( pxQueue )->ucQueueType, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting - 1 ); } while( 0 )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )  traceQUEUE_RECEIVE( pxQueue )
+#define traceTASK_SWITCHED_IN()                 trace_task_switched_in( pxCurrentTCB->uxTCBNumber )
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -93,7 +129,7 @@
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                10
-#define configTIMER_TASK_STACK_DEPTH            1024
+#define configTIMER_TASK_STACK_DEPTH            256
 
 /* Interrupt nesting behaviour configuration. */
 /*
@@ -102,13 +138,17 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-// #if FREE_RTOS_KERNEL_SMP // set by the RP2040 SMP port of FreeRTOS
-// /* SMP port only */
-// #define configNUMBER_OF_CORES                   2
-// #define configTICK_CORE                         0
-// #define configRUN_MULTIPLE_PRIORITIES           1
-// #define configUSE_CORE_AFFINITY                 1
-// #endif
+/* Dois núcleos com cmake -DPROJETO_SMP=ON; a divisão das tarefas está em src/cores.h */
+#if PROJETO_SMP
+#define configNUMBER_OF_CORES                   2
+#define configTICK_CORE                         0
+#define configRUN_MULTIPLE_PRIORITIES           1
+#define configUSE_CORE_AFFINITY                 1
+#define configUSE_PASSIVE_IDLE_HOOK             0
+#define configTIMER_SERVICE_TASK_CORE_AFFINITY  ( 1 << 0 )
+#else
+#define configNUMBER_OF_CORES                   1
+#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP         1
@@ -137,6 +177,12 @@ to exclude the API function. */
 #define INCLUDE_xTaskResumeFromISR              1
 #define INCLUDE_xQueueGetMutexHolder            1
 
+/* Tickless idle customizado (src/power.c): dorme até o próximo prazo ou até uma interrupção */
+#ifndef __ASSEMBLER__
+extern void vApplicationSleep( uint32_t xExpectedIdleTime );
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vApplicationSleep( xExpectedIdleTime )
+
 /* A header file that defines trace macro can be included here. */
 
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
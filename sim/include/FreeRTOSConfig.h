@@ -0,0 +1,108 @@
+// === Configuração do FreeRTOS para o simulador (porta POSIX) ===
+// Mesmos parâmetros de escalonamento do firmware (include/FreeRTOSConfig.h). Mudam só o que
+// depende do RP2040: sem tickless idle, com o hook do tick dirigindo os periféricos simulados
+// e com estatísticas de execução medidas em microssegundos.
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Scheduler Related */
+#define configUSE_PREEMPTION                    1
+#define configUSE_TICKLESS_IDLE                 0
+#define configNUMBER_OF_CORES                   1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     1
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                    32
+#define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 256
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+
+/* Synchronization Related */
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_APPLICATION_TASK_TAG          0
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    1
+#define configUSE_TIME_SLICING                  1
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+
+/* System */
+#define configSTACK_DEPTH_TYPE                  uint32_t
+#define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   (1024*1024)
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+/* Hook function related definitions. */
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+extern uint64_t sim_run_time_counter( void );
+extern void diag_queue_level( unsigned long uxQueueNumber, unsigned long uxWaiting );
+extern void trace_task_switched_in( unsigned long uxTaskNumber );
+extern void trace_queue( unsigned long xSend, unsigned long ucQueueType, unsigned long uxQueueNumber, unsigned long uxWaiting );
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        sim_run_time_counter()
+
+/* Pico de ocupação (src/diag.c) e eventos do trace (src/trace.c) das filas e mutexes
+   registrados com diag_add_queue (uxQueueNumber != 0) e troca de tarefa */
+#define traceQUEUE_SEND( pxQueue ) \
+    do { if( ( pxQueue )->uxQueueNumber != 0 ) { \
+        diag_queue_level( ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting + 1 ); \
+        trace_queue( 1, ( pxQueue )->ucQueueType, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting + 1 ); } } while( 0 )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )     traceQUEUE_SEND( pxQueue )
+#define traceQUEUE_RECEIVE( pxQueue ) \
+    do { if( ( pxQueue )->uxQueueNumber != 0 ) \
+        trace_queue( 0, ( pxQueue )->ucQueueType, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting - 1 ); } while( 0 )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )  traceQUEUE_RECEIVE( pxQueue )
+#define traceTASK_SWITCHED_IN()                 trace_task_switched_in( pxCurrentTCB->uxTCBNumber )
+
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         1
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            1024
+
+#include <assert.h>
+#define configASSERT(x)                         assert(x)
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  1
+#define INCLUDE_xTaskResumeFromISR              1
+#define INCLUDE_xQueueGetMutexHolder            1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,30 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t wake_en0, wake_en1, sleep_en0, sleep_en1;
+} clocks_hw_t;
+
+extern clocks_hw_t* clocks_hw;
+
+enum clock_index { clk_gpout0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+
+#define CLOCKS_SLEEP_EN0_CLK_SYS_I2C0_BITS 0x00000400u
+#define CLOCKS_SLEEP_EN0_CLK_SYS_I2C1_BITS 0x00000800u
+#define CLOCKS_SLEEP_EN0_CLK_SYS_PIO0_BITS 0x00004000u
+#define CLOCKS_SLEEP_EN0_CLK_SYS_PIO1_BITS 0x00008000u
+#define CLOCKS_SLEEP_EN0_CLK_SYS_PWM_BITS 0x00020000u
+#define CLOCKS_SLEEP_EN1_CLK_PERI_SPI0_BITS 0x00000001u
+#define CLOCKS_SLEEP_EN1_CLK_SYS_SPI0_BITS 0x00000002u
+#define CLOCKS_SLEEP_EN1_CLK_PERI_SPI1_BITS 0x00000004u
+#define CLOCKS_SLEEP_EN1_CLK_SYS_SPI1_BITS 0x00000008u
+#define CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS 0x00000400u
+#define CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS 0x00000800u
+#define CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS 0x00001000u
+#define CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS 0x00002000u
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SIM_HARDWARE_FLASH_H
+#define SIM_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+// A flash simulada é um vetor em RAM; o endereço XIP aponta para ele
+extern uint8_t sim_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)sim_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SIM_HARDWARE_PWM_H
+#define SIM_HARDWARE_PWM_H
+
+#include "pico/stdlib.h"
+
+#define NUM_PWM_SLICES 8
+
+typedef struct {
+    uint32_t csr, div, top;
+} pwm_config;
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1) & 7;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1;
+}
+
+pwm_config pwm_get_default_config(void);
+void pwm_init(uint slice_num, pwm_config* c, bool start);
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+void pwm_set_enabled(uint slice_num, bool enabled);
+
+#endif
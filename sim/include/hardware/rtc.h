@@ -0,0 +1,16 @@
+#ifndef SIM_HARDWARE_RTC_H
+#define SIM_HARDWARE_RTC_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    int16_t year;
+    int8_t month, day, dotw, hour, min, sec;
+} datetime_t;
+
+void rtc_init(void);
+bool rtc_set_datetime(const datetime_t* t);
+bool rtc_get_datetime(datetime_t* t);
+bool rtc_running(void);
+
+#endif
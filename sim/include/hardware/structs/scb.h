@@ -0,0 +1,14 @@
+#ifndef SIM_HARDWARE_STRUCTS_SCB_H
+#define SIM_HARDWARE_STRUCTS_SCB_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t cpuid, icsr, vtor, aircr, scr;
+} armv6m_scb_hw_t;
+
+extern armv6m_scb_hw_t* scb_hw;
+
+#define M0PLUS_SCR_SLEEPDEEP_BITS 0x00000004u
+
+#endif
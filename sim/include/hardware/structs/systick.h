@@ -0,0 +1,14 @@
+#ifndef SIM_HARDWARE_STRUCTS_SYSTICK_H
+#define SIM_HARDWARE_STRUCTS_SYSTICK_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t csr, rvr, cvr, calib;
+} systick_hw_t;
+
+extern systick_hw_t* systick_hw;
+
+#define M0PLUS_SYST_CSR_ENABLE_BITS 0x00000001u
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// No simulador não há interrupções de verdade: os periféricos simulados chamam os handlers
+// diretamente, então mascarar é só contabilidade
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+static inline void __wfi(void) {}
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
+static inline void __dmb(void) { __sync_synchronize(); }
+static inline uint get_core_num(void) { return 0; }
+
+#endif
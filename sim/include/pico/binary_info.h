@@ -0,0 +1,8 @@
+#ifndef SIM_PICO_BINARY_INFO_H
+#define SIM_PICO_BINARY_INFO_H
+
+// Os metadados do picotool não existem no executável do PC
+#define bi_decl(...)
+#define bi_decl_if_func_used(...)
+
+#endif
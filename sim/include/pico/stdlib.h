@@ -0,0 +1,43 @@
+// === Pico SDK simulado: pico/stdlib.h ===
+// Só o que o firmware usa, com as mesmas assinaturas do SDK
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define PICO_ON_DEVICE 0
+
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+
+absolute_time_t get_absolute_time(void);
+uint32_t to_ms_since_boot(absolute_time_t t);
+absolute_time_t from_us_since_boot(uint64_t us);
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_ms(uint32_t ms);
+void busy_wait_us_32(uint32_t us);
+static inline void tight_loop_contents(void) {}
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+int stdio_get_until(char* buf, int len, absolute_time_t until);
+int stdio_put_string(const char* s, int len, bool newline, bool cr_translation);
+void stdio_flush(void);
+void stdio_set_chars_available_callback(void (*fn)(void*), void* param);
+
+#include "hardware/gpio.h"
+
+#endif
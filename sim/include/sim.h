@@ -0,0 +1,48 @@
+// === Interface interna do simulador ===
+// Ligações entre os periféricos simulados, o display virtual e o roteiro de eventos
+#ifndef SIM_H
+#define SIM_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Entradas vindas do roteiro (chamadas no contexto do tick, que faz o papel de interrupção)
+void sim_gpio_set_input(uint gpio, bool level);
+void sim_adc_set(uint input, uint16_t value);
+void sim_adc_tick(void);
+void sim_stdin_push(const char* text);
+
+// Periféricos entre si
+void sim_dma_dreq(uint dreq, uint32_t value);
+void sim_irq_raise(uint num);
+void sim_i2c_data_cmd(i2c_inst_t* i2c, uint32_t word);
+bool sim_i2c_is_data_cmd(volatile void* addr, i2c_inst_t** i2c);
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;         // inclui o byte de endereço
+    uint32_t naks;
+    uint64_t bus_us;        // tempo estimado no barramento na frequência configurada
+} SimI2CStats;
+
+void sim_i2c_get_stats(i2c_inst_t* i2c, SimI2CStats* stats);
+
+// Display SSD1306 virtual no endereço 0x3C
+#define SIM_SSD1306_ADDRESS 0x3C
+void sim_ssd1306_start(void);
+void sim_ssd1306_byte(uint8_t b);
+void sim_ssd1306_stop(bool stop);
+uint32_t sim_ssd1306_frames(void);
+void sim_ssd1306_set_output(const char* dir);
+
+void sim_flash_load(const char* path);
+
+// Buzzer no PWM: notas iniciadas e tempo total com som
+typedef struct {
+    uint32_t notes;
+    uint64_t sounding_us;
+} SimPwmStats;
+
+void sim_pwm_get_stats(SimPwmStats* stats);
+
+#endif
@@ -0,0 +1,68 @@
+// === ADC simulado ===
+// Com adc_run ligado, cada tick produz uma conversão da entrada atual (1 kHz, a mesma taxa que
+// o firmware configura) e avança o round robin; com DREQ habilitado o valor vai para o DMA
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "sim.h"
+
+// As conversões são instantâneas: o ADC está sempre pronto
+static adc_hw_t regs = {.cs = ADC_CS_READY_BITS};
+adc_hw_t* adc_hw = &regs;
+
+static uint16_t values[5] = {2048, 2048, 2048, 2048, 876};  // a entrada 4 é o sensor de temperatura
+static uint input, round_robin;
+static bool running, fifo_dreq;
+
+void adc_init(void) {
+    input = round_robin = 0;
+    running = fifo_dreq = false;
+}
+
+void adc_gpio_init(uint gpio) {
+    gpio_init(gpio);
+    gpio_disable_pulls(gpio);
+}
+
+void adc_select_input(uint in) {
+    input = in;
+}
+
+uint16_t adc_read(void) {
+    return values[input];
+}
+
+void adc_set_round_robin(uint input_mask) {
+    round_robin = input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    fifo_dreq = en && dreq_en;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+}
+
+void adc_run(bool run) {
+    running = run;
+}
+
+void adc_fifo_drain(void) {
+}
+
+void sim_adc_set(uint in, uint16_t value) {
+    if (in < count_of(values)) values[in] = value & 0xFFF;
+}
+
+void sim_adc_tick(void) {
+    if (!running) return;
+    if (fifo_dreq) sim_dma_dreq(DREQ_ADC, values[input]);
+
+    // Próxima entrada habilitada no round robin
+    for (uint i = 1; round_robin && i <= 5; i++) {
+        uint next = (input + i) % 5;
+        if (round_robin & (1u << next)) {
+            input = next;
+            break;
+        }
+    }
+}
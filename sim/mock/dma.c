@@ -0,0 +1,212 @@
+// === DMA e interrupções simulados ===
+// Transferências para um periférico sem DREQ de amostragem (o i2c) acontecem por inteiro no
+// disparo e levantam a interrupção em seguida; canais ligados ao DREQ do ADC avançam uma
+// transferência por amostra, respeitando o anel de escrita
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "sim.h"
+
+typedef struct {
+    bool claimed, active;
+    dma_channel_config config;
+    volatile void* write_addr;
+    const volatile void* read_addr;
+    uint32_t count;
+} Channel;
+
+static Channel channels[NUM_DMA_CHANNELS];
+static uint32_t irq0_enabled, irq0_status, irq1_enabled, irq1_status;
+
+#define MAX_SHARED_HANDLERS 4
+static irq_handler_t handlers[NUM_IRQS][MAX_SHARED_HANDLERS];
+static bool irq_enabled[NUM_IRQS];
+
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!channels[i].claimed) {
+            channels[i].claimed = true;
+            return i;
+        }
+    }
+    assert(!required);
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){.size = DMA_SIZE_32, .read_increment = true, .dreq = DREQ_FORCE};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size) {
+    c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    c->read_increment = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    c->write_increment = incr;
+}
+
+void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits) {
+    c->ring_write = write;
+    c->ring_bits = size_bits;
+}
+
+void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+    c->dreq = dreq;
+}
+
+static uintptr_t advance(uintptr_t addr, bool ring, const dma_channel_config* c) {
+    uintptr_t next = addr + (1u << c->size);
+    if (ring && c->ring_bits) {
+        uintptr_t mask = ((uintptr_t)1 << c->ring_bits) - 1;
+        next = (addr & ~mask) | (next & mask);
+    }
+    return next;
+}
+
+static uint32_t read_item(const volatile void* addr, uint8_t size) {
+    if (size == DMA_SIZE_8) return *(const volatile uint8_t*)addr;
+    if (size == DMA_SIZE_16) return *(const volatile uint16_t*)addr;
+    return *(const volatile uint32_t*)addr;
+}
+
+static void write_item(volatile void* addr, uint8_t size, uint32_t value) {
+    if (size == DMA_SIZE_8) *(volatile uint8_t*)addr = value;
+    else if (size == DMA_SIZE_16) *(volatile uint16_t*)addr = value;
+    else *(volatile uint32_t*)addr = value;
+}
+
+static void complete(uint channel) {
+    channels[channel].active = false;
+    if (irq0_enabled & (1u << channel)) {
+        irq0_status |= 1u << channel;
+        sim_irq_raise(DMA_IRQ_0);
+    }
+    if (irq1_enabled & (1u << channel)) {
+        irq1_status |= 1u << channel;
+        sim_irq_raise(DMA_IRQ_1);
+    }
+}
+
+// Uma transferência; no endereço de dados do i2c o valor vira um byte no barramento
+static void transfer(Channel* ch, uint32_t value) {
+    i2c_inst_t* i2c;
+    if (sim_i2c_is_data_cmd(ch->write_addr, &i2c)) sim_i2c_data_cmd(i2c, value);
+    else write_item(ch->write_addr, ch->config.size, value);
+
+    if (ch->config.read_increment) {
+        ch->read_addr = (const volatile void*)advance((uintptr_t)ch->read_addr, !ch->config.ring_write, &ch->config);
+    }
+    if (ch->config.write_increment) {
+        ch->write_addr = (volatile void*)advance((uintptr_t)ch->write_addr, ch->config.ring_write, &ch->config);
+    }
+    ch->count--;
+}
+
+static void start(uint channel) {
+    Channel* ch = &channels[channel];
+    ch->active = ch->count > 0;
+    if (ch->config.dreq == DREQ_ADC) return;
+
+    while (ch->active && ch->count > 0) {
+        transfer(ch, read_item(ch->read_addr, ch->config.size));
+    }
+    complete(channel);
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint32_t transfer_count, bool trigger) {
+    Channel* ch = &channels[channel];
+    ch->config = *config;
+    ch->write_addr = write_addr;
+    ch->read_addr = read_addr;
+    ch->count = transfer_count;
+    if (trigger) start(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void* read_addr, uint32_t transfer_count) {
+    channels[channel].read_addr = read_addr;
+    channels[channel].count = transfer_count;
+    start(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    channels[channel].count = trans_count;
+    if (trigger) start(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    channels[channel].active = false;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return channels[channel].active;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    if (enabled) irq0_enabled |= 1u << channel;
+    else irq0_enabled &= ~(1u << channel);
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return irq0_status & (1u << channel);
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    irq0_status &= ~(1u << channel);
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    if (enabled) irq1_enabled |= 1u << channel;
+    else irq1_enabled &= ~(1u << channel);
+}
+
+bool dma_channel_get_irq1_status(uint channel) {
+    return irq1_status & (1u << channel);
+}
+
+void dma_channel_acknowledge_irq1(uint channel) {
+    irq1_status &= ~(1u << channel);
+}
+
+// Uma requisição do periférico: serve os canais ativos ligados a esse DREQ
+void sim_dma_dreq(uint dreq, uint32_t value) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        Channel* ch = &channels[i];
+        if (!ch->active || ch->config.dreq != dreq) continue;
+        transfer(ch, value);
+        if (ch->count == 0) complete(i);
+    }
+}
+
+// === Interrupções ===
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    for (int i = 0; i < MAX_SHARED_HANDLERS; i++) {
+        if (!handlers[num][i]) {
+            handlers[num][i] = handler;
+            return;
+        }
+    }
+    assert(false);
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    handlers[num][0] = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irq_enabled[num] = enabled;
+}
+
+void sim_irq_raise(uint num) {
+    if (!irq_enabled[num]) return;
+    for (int i = 0; i < MAX_SHARED_HANDLERS && handlers[num][i]; i++) {
+        handlers[num][i]();
+    }
+}
@@ -0,0 +1,52 @@
+// === Flash simulada ===
+// Um vetor em RAM com a semântica da NOR: apagar leva a 0xFF e gravar só zera bits. Se houver
+// um arquivo de imagem, ele é carregado no início e regravado a cada operação, então o log de
+// lembretes sobrevive entre execuções como sobreviveria a um reset.
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+uint8_t sim_flash[PICO_FLASH_SIZE_BYTES];
+static const char* image_path;
+
+static void save(void) {
+    if (!image_path) return;
+    FILE* f = fopen(image_path, "wb");
+    if (!f) return;
+    fwrite(sim_flash, 1, sizeof sim_flash, f);
+    fclose(f);
+}
+
+void sim_flash_load(const char* path) {
+    memset(sim_flash, 0xFF, sizeof sim_flash);
+    image_path = path;
+
+    FILE* f = path ? fopen(path, "rb") : NULL;
+    if (!f) return;
+    size_t n = fread(sim_flash, 1, sizeof sim_flash, f);
+    fclose(f);
+    if (n != sizeof sim_flash) memset(sim_flash, 0xFF, sizeof sim_flash);
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    assert(flash_offs % FLASH_SECTOR_SIZE == 0 && count % FLASH_SECTOR_SIZE == 0);
+    assert(flash_offs + count <= sizeof sim_flash);
+    memset(sim_flash + flash_offs, 0xFF, count);
+    save();
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count) {
+    assert(flash_offs % FLASH_PAGE_SIZE == 0 && count % FLASH_PAGE_SIZE == 0);
+    assert(flash_offs + count <= sizeof sim_flash);
+    for (size_t i = 0; i < count; i++) {
+        sim_flash[flash_offs + i] &= data[i];
+    }
+    save();
+}
+
+int flash_safe_execute(void (*func)(void*), void* param, uint32_t enter_exit_timeout_ms) {
+    func(param);
+    return PICO_OK;
+}
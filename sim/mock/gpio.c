@@ -0,0 +1,69 @@
+// === GPIO simulado ===
+// Entradas com pull-up ficam em 1 até o roteiro mudar o nível; bordas habilitadas chamam o
+// callback como a interrupção do banco 0 faria
+#include "hardware/gpio.h"
+#include "sim.h"
+
+typedef struct {
+    bool out, level, pull_up, pull_down;
+    uint32_t irq_mask;
+    enum gpio_function fn;
+} Pin;
+
+static Pin pins[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t callback;
+
+void gpio_init(uint gpio) {
+    pins[gpio] = (Pin){.fn = GPIO_FUNC_SIO};
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    pins[gpio].out = out;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    pins[gpio].fn = fn;
+}
+
+void gpio_pull_up(uint gpio) {
+    pins[gpio].pull_up = true;
+    pins[gpio].pull_down = false;
+    if (!pins[gpio].out) pins[gpio].level = true;
+}
+
+void gpio_pull_down(uint gpio) {
+    pins[gpio].pull_up = false;
+    pins[gpio].pull_down = true;
+    if (!pins[gpio].out) pins[gpio].level = false;
+}
+
+void gpio_disable_pulls(uint gpio) {
+    pins[gpio].pull_up = pins[gpio].pull_down = false;
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (pins[gpio].out) pins[gpio].level = value;
+}
+
+bool gpio_get(uint gpio) {
+    return pins[gpio].level;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (enabled) pins[gpio].irq_mask |= event_mask;
+    else pins[gpio].irq_mask &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t cb) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    callback = cb;
+}
+
+void sim_gpio_set_input(uint gpio, bool level) {
+    Pin* p = &pins[gpio];
+    if (p->out || p->level == level) return;
+    p->level = level;
+
+    uint32_t event = level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if (callback && (p->irq_mask & event)) callback(gpio, event);
+}
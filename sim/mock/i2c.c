@@ -0,0 +1,113 @@
+// === I2C simulado ===
+// Os dois caminhos do driver chegam ao mesmo barramento: i2c_write_blocking e as palavras que
+// o DMA escreve em IC_DATA_CMD (com os bits de RESTART e STOP). Só o SSD1306 virtual responde;
+// outros endereços recebem NAK. O tempo de barramento é estimado com 9 bits por byte.
+#include "hardware/i2c.h"
+#include "sim.h"
+
+struct i2c_inst {
+    i2c_hw_t hw;
+    uint baudrate;
+    bool active;        // transação aberta (sem STOP)
+    uint64_t bus_bits;
+    SimI2CStats stats;
+};
+
+i2c_inst_t i2c0_inst, i2c1_inst;
+
+static void start(i2c_inst_t* i2c, uint8_t addr) {
+    if (i2c->active) sim_ssd1306_stop(false);
+    i2c->active = true;
+    i2c->stats.transactions++;
+    i2c->stats.bytes++;
+    if (addr == SIM_SSD1306_ADDRESS) sim_ssd1306_start();
+}
+
+static void byte(i2c_inst_t* i2c, uint8_t addr, uint8_t b) {
+    i2c->stats.bytes++;
+    if (addr == SIM_SSD1306_ADDRESS) sim_ssd1306_byte(b);
+}
+
+static void stop(i2c_inst_t* i2c, uint8_t addr) {
+    i2c->active = false;
+    if (addr == SIM_SSD1306_ADDRESS) sim_ssd1306_stop(true);
+}
+
+// Cada byte ocupa o barramento por 8 bits mais o ACK
+static void account(i2c_inst_t* i2c, size_t bytes) {
+    i2c->bus_bits += bytes * 9;
+}
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    i2c->active = false;
+    i2c->hw.enable = 1;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t* i2c) {
+    i2c->hw.enable = 0;
+}
+
+uint i2c_set_baudrate(i2c_inst_t* i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    if (addr != SIM_SSD1306_ADDRESS) {
+        i2c->stats.naks++;
+        i2c->active = false;
+        return PICO_ERROR_GENERIC;
+    }
+
+    start(i2c, addr);
+    for (size_t i = 0; i < len; i++) {
+        byte(i2c, addr, src[i]);
+    }
+    if (!nostop) stop(i2c, addr);
+    account(i2c, len + 1);
+    return len;
+}
+
+int i2c_write_timeout_us(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop, uint timeout_us) {
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+i2c_hw_t* i2c_get_hw(i2c_inst_t* i2c) {
+    return &i2c->hw;
+}
+
+uint i2c_hw_index(i2c_inst_t* i2c) {
+    return i2c == &i2c1_inst;
+}
+
+uint i2c_get_dreq(i2c_inst_t* i2c, bool is_tx) {
+    return 32 + 2 * i2c_hw_index(i2c) + !is_tx;
+}
+
+bool sim_i2c_is_data_cmd(volatile void* addr, i2c_inst_t** i2c) {
+    if (addr == &i2c0_inst.hw.data_cmd) *i2c = &i2c0_inst;
+    else if (addr == &i2c1_inst.hw.data_cmd) *i2c = &i2c1_inst;
+    else return false;
+    return true;
+}
+
+// Palavra escrita em IC_DATA_CMD: o endereço é o de IC_TAR
+void sim_i2c_data_cmd(i2c_inst_t* i2c, uint32_t word) {
+    uint8_t addr = i2c->hw.tar & 0x7F;
+
+    if (!i2c->active || (word & I2C_IC_DATA_CMD_RESTART_BITS)) {
+        if (addr != SIM_SSD1306_ADDRESS) i2c->stats.naks++;
+        start(i2c, addr);
+        account(i2c, 1);
+    }
+    byte(i2c, addr, word & 0xFF);
+    account(i2c, 1);
+    if (word & I2C_IC_DATA_CMD_STOP_BITS) stop(i2c, addr);
+}
+
+void sim_i2c_get_stats(i2c_inst_t* i2c, SimI2CStats* stats) {
+    *stats = i2c->stats;
+    stats->bus_us = i2c->baudrate ? i2c->bus_bits * 1000000 / i2c->baudrate : 0;
+}
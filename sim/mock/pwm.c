@@ -0,0 +1,66 @@
+// === PWM simulado ===
+// Guarda a configuração de cada fatia; um canal com nível acima de zero numa fatia ligada
+// conta como nota tocando, para o relatório do simulador (o buzzer)
+#include "hardware/pwm.h"
+#include "sim.h"
+
+typedef struct {
+    bool enabled;
+    uint8_t div;
+    uint16_t wrap;
+    uint16_t level[2];
+} Slice;
+
+static Slice slices[NUM_PWM_SLICES];
+static SimPwmStats stats;
+static uint64_t sounding_since;
+
+static bool sounding(void) {
+    for (int s = 0; s < NUM_PWM_SLICES; s++) {
+        if (slices[s].enabled && (slices[s].level[0] || slices[s].level[1])) return true;
+    }
+    return false;
+}
+
+// Fecha ou abre o intervalo com som depois de cada mudança
+static void update(bool was) {
+    bool now = sounding();
+    if (was && !now) stats.sounding_us += time_us_64() - sounding_since;
+    if (!was && now) sounding_since = time_us_64();
+}
+
+pwm_config pwm_get_default_config(void) {
+    return (pwm_config){.csr = 0, .div = 1 << 4, .top = 0xffff};
+}
+
+void pwm_init(uint slice_num, pwm_config* c, bool start) {
+    bool was = sounding();
+    slices[slice_num] = (Slice){.enabled = start, .div = c->div >> 4, .wrap = c->top};
+    update(was);
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    slices[slice_num].div = integer;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    slices[slice_num].wrap = wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    bool was = sounding();
+    slices[slice_num].level[chan] = level;
+    if (level && slices[slice_num].enabled) stats.notes++;
+    update(was);
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    bool was = sounding();
+    slices[slice_num].enabled = enabled;
+    update(was);
+}
+
+void sim_pwm_get_stats(SimPwmStats* out) {
+    *out = stats;
+    if (sounding()) out->sounding_us += time_us_64() - sounding_since;
+}
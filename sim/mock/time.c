@@ -0,0 +1,160 @@
+// === Tempo, RTC, alarmes e stdio simulados ===
+#include "pico/stdlib.h"
+#include "hardware/rtc.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/systick.h"
+#include "sim.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+// Registros que o firmware só escreve (sono profundo e clock gating não existem no PC)
+static clocks_hw_t clocks_regs = {.sleep_en0 = 0xFFFFFFFF, .sleep_en1 = 0xFFFFFFFF};
+static armv6m_scb_hw_t scb_regs;
+static systick_hw_t systick_regs = {.rvr = 124999};
+clocks_hw_t* clocks_hw = &clocks_regs;
+armv6m_scb_hw_t* scb_hw = &scb_regs;
+systick_hw_t* systick_hw = &systick_regs;
+
+// === Tempo desde o boot ===
+static uint64_t monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint64_t boot_us;
+
+__attribute__((constructor)) static void time_setup(void) {
+    boot_us = monotonic_us();
+}
+
+uint64_t time_us_64(void) {
+    return monotonic_us() - boot_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+void sleep_ms(uint32_t ms) {
+    usleep(ms * 1000);
+}
+
+void busy_wait_us_32(uint32_t us) {
+    usleep(us);
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_sys ? 125000000 : 48000000;
+}
+
+// === Alarmes (usados só pelo tickless idle, que fica desligado no simulador) ===
+int hardware_alarm_claim_unused(bool required) {
+    return 3;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) {
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+    return true;
+}
+
+void hardware_alarm_cancel(uint alarm_num) {
+}
+
+// === RTC: data acertada mais o tempo decorrido desde o acerto ===
+static bool rtc_set;
+static time_t rtc_epoch;
+static uint64_t rtc_set_us;
+
+void rtc_init(void) {
+    rtc_set = false;
+}
+
+bool rtc_set_datetime(const datetime_t* t) {
+    struct tm tm = {
+        .tm_year = t->year - 1900, .tm_mon = t->month - 1, .tm_mday = t->day,
+        .tm_hour = t->hour, .tm_min = t->min, .tm_sec = t->sec
+    };
+    rtc_epoch = timegm(&tm);
+    rtc_set_us = time_us_64();
+    rtc_set = true;
+    return true;
+}
+
+bool rtc_get_datetime(datetime_t* t) {
+    if (!rtc_set) return false;
+
+    time_t now = rtc_epoch + (time_t)((time_us_64() - rtc_set_us) / 1000000);
+    struct tm tm;
+    gmtime_r(&now, &tm);
+    *t = (datetime_t){
+        .year = tm.tm_year + 1900, .month = tm.tm_mon + 1, .day = tm.tm_mday, .dotw = tm.tm_wday,
+        .hour = tm.tm_hour, .min = tm.tm_min, .sec = tm.tm_sec
+    };
+    return true;
+}
+
+bool rtc_running(void) {
+    return rtc_set;
+}
+
+// === stdio: a saída vai para o terminal; a entrada vem do roteiro ("shell ...") ===
+static char input[256];
+static volatile uint32_t input_head, input_tail;
+static void (*chars_callback)(void*);
+static void* chars_param;
+
+bool stdio_init_all(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return true;
+}
+
+void stdio_set_chars_available_callback(void (*fn)(void*), void* param) {
+    chars_callback = fn;
+    chars_param = param;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    if (input_tail == input_head) return PICO_ERROR_TIMEOUT;
+    return input[input_tail++ % sizeof input];
+}
+
+int stdio_get_until(char* buf, int len, absolute_time_t until) {
+    int n = 0;
+    while (n < len && input_tail != input_head) buf[n++] = input[input_tail++ % sizeof input];
+    return n ? n : PICO_ERROR_TIMEOUT;
+}
+
+int stdio_put_string(const char* s, int len, bool newline, bool cr_translation) {
+    fwrite(s, 1, len, stdout);
+    if (newline) putchar('\n');
+    return len;
+}
+
+void stdio_flush(void) {
+    fflush(stdout);
+}
+
+void sim_stdin_push(const char* text) {
+    for (; *text && input_head - input_tail < sizeof input; text++) {
+        input[input_head++ % sizeof input] = *text;
+    }
+    if (chars_callback) chars_callback(chars_param);
+}
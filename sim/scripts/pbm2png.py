@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Converte os quadros PBM do simulador em PNG (só com a biblioteca padrão).
+
+Uso: pbm2png.py [--scale N] ARQUIVO_OU_PASTA...
+Cada frame_*.pbm vira frame_*.png ao lado, ampliado N vezes (padrão 4), com os pixels
+acesos em branco sobre fundo preto, como no OLED.
+"""
+import argparse
+import pathlib
+import struct
+import zlib
+
+
+def read_pbm(path):
+    data = path.read_bytes()
+    fields = []
+    pos = 0
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P4":
+        raise ValueError(f"{path}: só PBM binário (P4) é suportado")
+    width, height = int(fields[1]), int(fields[2])
+    stride = (width + 7) // 8
+    bits = data[pos + 1:pos + 1 + stride * height]
+    return width, height, [[bool(bits[y * stride + x // 8] & (0x80 >> x % 8)) for x in range(width)]
+                           for y in range(height)]
+
+
+def write_png(path, width, height, rows, scale):
+    raw = bytearray()
+    for row in rows:
+        line = bytes(255 if on else 0 for on in row for _ in range(scale))
+        for _ in range(scale):
+            raw += b"\x00" + line
+
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+
+    header = struct.pack(">IIBBBBB", width * scale, height * scale, 8, 0, 0, 0, 0)
+    path.write_bytes(b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", header) +
+                     chunk(b"IDAT", zlib.compress(bytes(raw), 9)) + chunk(b"IEND", b""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--scale", type=int, default=4)
+    parser.add_argument("paths", nargs="+", type=pathlib.Path)
+    args = parser.parse_args()
+
+    files = []
+    for p in args.paths:
+        files += sorted(p.glob("frame_*.pbm")) if p.is_dir() else [p]
+    for f in files:
+        width, height, rows = read_pbm(f)
+        write_png(f.with_suffix(".png"), width, height, rows, args.scale)
+    print(f"{len(files)} quadros convertidos")
+
+
+if __name__ == "__main__":
+    main()
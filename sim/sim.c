@@ -0,0 +1,141 @@
+// === Roteiro de eventos e relatório do simulador ===
+// O roteiro (arquivo em SIM_SCRIPT) tem uma linha por evento, com o instante em ms desde o boot:
+//
+//   1000 press 5          botão no GPIO 5 pressionado (nível 0)
+//   1100 release 5        botão solto
+//   2000 adc 1 4000       valor de 12 bits na entrada 1 do ADC (joystick)
+//   3000 shell time 2025-01-01 08:00
+//   9000 stats            imprime o relatório
+//   9500 quit             imprime o relatório e encerra
+//
+// Os eventos são aplicados pelo hook do tick, que faz o papel das interrupções. Os quadros do
+// display vão para SIM_OUT (padrão sim_out) e a flash persiste em SIM_OUT/flash.bin.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "inc/ssd1306.h"
+#include "ui.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define SIM_MAX_EVENTS 1024
+#define SIM_MAX_TASKS 16
+
+typedef struct {
+    uint32_t time_ms;
+    char action[12];
+    char args[84];
+} Event;
+
+static Event events[SIM_MAX_EVENTS];
+static int n_events, next_event;
+
+static void load_script(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "sim: roteiro %s nao encontrado\n", path);
+        exit(1);
+    }
+
+    char line[128];
+    while (fgets(line, sizeof line, f) && n_events < SIM_MAX_EVENTS) {
+        Event* e = &events[n_events];
+        int used = 0;
+        if (line[0] == '#' || sscanf(line, "%lu %11s %n", (unsigned long*)&e->time_ms, e->action, &used) < 2) continue;
+        snprintf(e->args, sizeof e->args, "%s", line + used);
+        e->args[strcspn(e->args, "\r\n")] = '\0';
+        n_events++;
+    }
+    fclose(f);
+}
+
+// Antes do main do firmware: saída, flash persistida e roteiro
+__attribute__((constructor)) static void sim_setup(void) {
+    const char* out = getenv("SIM_OUT") ? getenv("SIM_OUT") : "sim_out";
+    mkdir(out, 0755);
+    sim_ssd1306_set_output(out);
+
+    static char flash_path[300];
+    snprintf(flash_path, sizeof flash_path, "%s/flash.bin", out);
+    sim_flash_load(flash_path);
+
+    if (getenv("SIM_SCRIPT")) load_script(getenv("SIM_SCRIPT"));
+}
+
+// === Relatório ===
+uint64_t sim_run_time_counter(void) {
+    return time_us_64();
+}
+
+static void report(void* quit, uint32_t unused) {
+    SimI2CStats i2c;
+    sim_i2c_get_stats(i2c1, &i2c);
+    const struct ssd1306_flush_stats* flush = ssd1306_get_flush_stats();
+    SimPwmStats pwm;
+    sim_pwm_get_stats(&pwm);
+    UiStats ui;
+    ui_get_stats(&ui);
+    uint32_t ms = to_ms_since_boot(get_absolute_time());
+
+    printf("\n=== sim: %lu ms ===\n", (unsigned long)ms);
+    printf("i2c1: %lu transacoes, %lu bytes, %lu NAK, %llu us no barramento (%lu.%lu%%)\n",
+           (unsigned long)i2c.transactions, (unsigned long)i2c.bytes, (unsigned long)i2c.naks,
+           (unsigned long long)i2c.bus_us, (unsigned long)(ms ? i2c.bus_us / ms / 10 : 0),
+           (unsigned long)(ms ? i2c.bus_us / ms % 10 : 0));
+    printf("display: %lu quadros recebidos, %lu enviados, %lu bytes enviados, %lu poupados\n",
+           (unsigned long)sim_ssd1306_frames(), (unsigned long)flush->frames,
+           (unsigned long)flush->bytes_sent, (unsigned long)flush->bytes_saved);
+    printf("buzzer: %lu notas, %llu ms com som\n", (unsigned long)pwm.notes,
+           (unsigned long long)(pwm.sounding_us / 1000));
+    printf("ui: %lu atualizacoes, %lu sem mudanca, %lu telas inteiras, %lu widgets\n",
+           (unsigned long)ui.refreshes, (unsigned long)ui.idle, (unsigned long)ui.full,
+           (unsigned long)ui.widgets);
+
+    TaskStatus_t tasks[SIM_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t n = uxTaskGetSystemState(tasks, SIM_MAX_TASKS, &total);
+    printf("%-12s %12s %7s\n", "tarefa", "us", "cpu");
+    for (UBaseType_t i = 0; i < n; i++) {
+        uint64_t us = tasks[i].ulRunTimeCounter;
+        printf("%-12s %12llu %6.2f%%\n", tasks[i].pcTaskName, (unsigned long long)us,
+               total ? 100.0 * us / total : 0.0);
+    }
+
+    if (quit) exit(0);
+}
+
+// === Eventos ===
+static void apply(const Event* e) {
+    BaseType_t woken = pdFALSE;
+    unsigned a, b;
+
+    if (strcmp(e->action, "press") == 0 && sscanf(e->args, "%u", &a) == 1) {
+        sim_gpio_set_input(a, false);
+    } else if (strcmp(e->action, "release") == 0 && sscanf(e->args, "%u", &a) == 1) {
+        sim_gpio_set_input(a, true);
+    } else if (strcmp(e->action, "adc") == 0 && sscanf(e->args, "%u %u", &a, &b) == 2) {
+        sim_adc_set(a, b);
+    } else if (strcmp(e->action, "shell") == 0) {
+        char line[sizeof e->args + 1];
+        snprintf(line, sizeof line, "%s\n", e->args);
+        sim_stdin_push(line);
+    } else if (strcmp(e->action, "stats") == 0 || strcmp(e->action, "quit") == 0) {
+        // O relatório percorre as tarefas, o que não pode ser feito no contexto do tick
+        xTimerPendFunctionCallFromISR(report, (void*)(uintptr_t)(e->action[0] == 'q'), 0, &woken);
+    } else {
+        fprintf(stderr, "sim: evento desconhecido: %s %s\n", e->action, e->args);
+    }
+}
+
+// Chamado a cada tick (1 ms): amostra do ADC e eventos do roteiro que venceram
+void vApplicationTickHook(void) {
+    sim_adc_tick();
+
+    TickType_t now = xTaskGetTickCountFromISR();
+    while (next_event < n_events && events[next_event].time_ms <= now * portTICK_PERIOD_MS) {
+        apply(&events[next_event++]);
+    }
+}
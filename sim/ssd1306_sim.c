@@ -0,0 +1,173 @@
+// === SSD1306 virtual ===
+// Decodifica o que chega pelo i2c como o controlador faria: byte de controle (Co e D/C),
+// comandos com seus argumentos e dados gravados na GDDRAM conforme o modo de endereçamento.
+// Cada transação terminada em STOP que gravou dados gera um quadro em PBM, já com
+// liga/desliga, inversão e espelhamentos aplicados (pixel aceso = preto no arquivo).
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WIDTH 128
+#define HEIGHT 64
+#define PAGES (HEIGHT / 8)
+
+enum { EXPECT_CONTROL, SINGLE_COMMAND, SINGLE_DATA, STREAM_COMMAND, STREAM_DATA };
+
+static uint8_t gddram[PAGES][WIDTH];
+static int state;
+
+// Registradores do controlador
+static uint8_t mode = 2;                // 0 horizontal, 1 vertical, 2 página (padrão após reset)
+static uint8_t col, col_start, col_end = WIDTH - 1;
+static uint8_t page, page_start, page_end = PAGES - 1;
+static uint8_t start_line;
+static bool display_on, inverted, entire_on, seg_remap, com_remap;
+
+// Comando em montagem (o primeiro byte e os argumentos que já chegaram)
+static uint8_t cmd[8];
+static int cmd_len, cmd_need;
+
+static bool dirty;
+static uint32_t frames;
+static char out_dir[256];
+
+// Quantos argumentos seguem cada comando
+static int arg_count(uint8_t c) {
+    switch (c) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void execute(void) {
+    uint8_t c = cmd[0];
+
+    if (c <= 0x0F) col = (col & 0xF0) | c;
+    else if (c <= 0x1F) col = (col & 0x0F) | (c & 0x0F) << 4;
+    else if (c == 0x20) mode = cmd[1] & 3;
+    else if (c == 0x21) {
+        col_start = col = cmd[1] & 0x7F;
+        col_end = cmd[2] & 0x7F;
+    } else if (c == 0x22) {
+        page_start = page = cmd[1] & 7;
+        page_end = cmd[2] & 7;
+    } else if (c >= 0x40 && c <= 0x7F) start_line = c & 0x3F;
+    else if (c == 0xA0 || c == 0xA1) seg_remap = c & 1;
+    else if (c == 0xA4 || c == 0xA5) entire_on = c & 1;
+    else if (c == 0xA6 || c == 0xA7) inverted = c & 1;
+    else if (c == 0xAE || c == 0xAF) display_on = c & 1;
+    else if (c >= 0xB0 && c <= 0xB7) page = c & 7;
+    else if (c == 0xC0 || c == 0xC8) com_remap = c == 0xC8;
+    else return;    // contraste, timing, charge pump, rolagem: não mudam a imagem simulada
+
+    dirty = true;
+}
+
+static void command(uint8_t b) {
+    if (cmd_len == 0) cmd_need = arg_count(b);
+    cmd[cmd_len++] = b;
+    if (cmd_len > cmd_need) {
+        execute();
+        cmd_len = 0;
+    }
+}
+
+// Grava um byte de dados e avança o ponteiro como o modo de endereçamento manda
+static void data(uint8_t b) {
+    gddram[page][col] = b;
+    dirty = true;
+
+    if (mode == 0) {
+        if (col++ >= col_end) {
+            col = col_start;
+            page = page >= page_end ? page_start : page + 1;
+        }
+    } else if (mode == 1) {
+        if (page++ >= page_end) {
+            page = page_start;
+            col = col >= col_end ? col_start : col + 1;
+        }
+    } else {
+        col = (col + 1) % WIDTH;
+    }
+}
+
+// Pixel que aparece na posição (x, y) da tela
+static bool pixel(int x, int y) {
+    if (!display_on) return false;
+    if (entire_on) return true;
+
+    int seg = seg_remap ? x : WIDTH - 1 - x;
+    int row = ((com_remap ? y : HEIGHT - 1 - y) + start_line) % HEIGHT;
+    bool on = gddram[row / 8][seg] & (1u << (row % 8));
+    return on != inverted;
+}
+
+static void dump(void) {
+    char path[300];
+    snprintf(path, sizeof path, "%s/frame_%05lu_%08lums.pbm", out_dir, (unsigned long)frames,
+             (unsigned long)to_ms_since_boot(get_absolute_time()));
+    frames++;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return;
+    fprintf(f, "P4\n%d %d\n", WIDTH, HEIGHT);
+    for (int y = 0; y < HEIGHT; y++) {
+        uint8_t row[WIDTH / 8] = {0};
+        for (int x = 0; x < WIDTH; x++) {
+            if (pixel(x, y)) row[x / 8] |= 0x80 >> (x % 8);
+        }
+        fwrite(row, 1, sizeof row, f);
+    }
+    fclose(f);
+}
+
+void sim_ssd1306_set_output(const char* dir) {
+    snprintf(out_dir, sizeof out_dir, "%s", dir);
+}
+
+void sim_ssd1306_start(void) {
+    state = EXPECT_CONTROL;
+}
+
+void sim_ssd1306_byte(uint8_t b) {
+    switch (state) {
+        case EXPECT_CONTROL:
+            if (b & 0x80) state = b & 0x40 ? SINGLE_DATA : SINGLE_COMMAND;
+            else state = b & 0x40 ? STREAM_DATA : STREAM_COMMAND;
+            break;
+        case SINGLE_COMMAND:
+            command(b);
+            state = EXPECT_CONTROL;
+            break;
+        case SINGLE_DATA:
+            data(b);
+            state = EXPECT_CONTROL;
+            break;
+        case STREAM_COMMAND:
+            command(b);
+            break;
+        case STREAM_DATA:
+            data(b);
+            break;
+    }
+}
+
+void sim_ssd1306_stop(bool stop) {
+    if (stop && dirty && out_dir[0]) {
+        dump();
+        dirty = false;
+    }
+}
+
+uint32_t sim_ssd1306_frames(void) {
+    return frames;
+}
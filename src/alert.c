@@ -0,0 +1,236 @@
+// === Despacho de alertas ===
+// Entre o agendador e a tela de alerta. Cada lembrete tem no máximo um alerta pendente,
+// marcado num mapa de bits pelo id: um disparo nunca espera nem se perde por falta de espaço,
+// e um novo disparo do mesmo lembrete é juntado ao que ainda não foi atendido. A vAlert é
+// acordada por um bit de notificação e recolhe os pendentes num grupo, em ordem de
+// prioridade e de atraso. O adiamento arma um timer de disparo único, que devolve os
+// lembretes aos pendentes quando vence.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "trace.h"
+#include "diag.h"
+#include "alert.h"
+#include <string.h>
+
+#define ID_WORDS ((MAX_REMINDERS + 31) / 32)
+
+typedef struct {
+    uint32_t first_ms;
+    uint8_t fired;
+    bool snoozed;
+} Pending;
+
+typedef struct {
+    TimerHandle_t timer;
+    StaticTimer_t timer_buf;
+    uint32_t ids[ID_WORDS];
+    bool busy;
+    TickType_t expiry;
+} Snooze;
+
+static uint32_t pending_map[ID_WORDS];
+static Pending pending[MAX_REMINDERS];
+static Snooze snoozes[ALERT_SNOOZE_SLOTS];
+static TaskHandle_t hConsumer;
+static AlertStats stats;
+
+static bool test(const uint32_t* map, int id) {
+    return map[id / 32] & (1u << (id % 32));
+}
+
+static void set(uint32_t* map, int id) {
+    map[id / 32] |= 1u << (id % 32);
+}
+
+static void clear(uint32_t* map, int id) {
+    map[id / 32] &= ~(1u << (id % 32));
+}
+
+static bool any(const uint32_t* map) {
+    for (int w = 0; w < ID_WORDS; w++) {
+        if (map[w]) return true;
+    }
+    return false;
+}
+
+// Marca o lembrete como pendente (chamar em seção crítica)
+static void mark(int id, bool snoozed) {
+    stats.fired++;
+    if (test(pending_map, id)) {
+        if (pending[id].fired < UINT8_MAX) pending[id].fired++;
+        pending[id].snoozed |= snoozed;
+        stats.coalesced++;
+        return;
+    }
+    set(pending_map, id);
+    pending[id] = (Pending){xTaskGetTickCount(), 1, snoozed};
+}
+
+// === Adiamentos ===
+static void snooze_callback(TimerHandle_t timer) {
+    Snooze* s = &snoozes[(intptr_t)pvTimerGetTimerID(timer)];
+
+    taskENTER_CRITICAL();
+    // Prazo antigo de um timer que alert_dismiss acabou de estender: os lembretes, velhos e novos,
+    // esperam o novo prazo, que o xTimerChangePeriod dele arma
+    if ((int32_t)(xTaskGetTickCount() - s->expiry) < 0) {
+        taskEXIT_CRITICAL();
+        return;
+    }
+    for (int w = 0; w < ID_WORDS; w++) {
+        for (uint32_t bits = s->ids[w]; bits; bits &= bits - 1) {
+            mark(w * 32 + __builtin_ctz(bits), true);
+        }
+        s->ids[w] = 0;
+    }
+    s->busy = false;
+    taskEXIT_CRITICAL();
+
+    xTaskNotify(hConsumer, ALERT_NOTIFY_DUE, eSetBits);
+}
+
+// Timer livre; com todos ocupados, o que vence por último recebe os novos lembretes e passa a
+// vencer no prazo deles, que é o mais longe: o adiamento de alguém cresce, mas nada se perde
+static Snooze* snooze_slot(void) {
+    Snooze* last = &snoozes[0];
+    for (int i = 0; i < ALERT_SNOOZE_SLOTS; i++) {
+        if (!snoozes[i].busy) return &snoozes[i];
+        if ((int32_t)(snoozes[i].expiry - last->expiry) > 0) last = &snoozes[i];
+    }
+    return last;
+}
+
+// === Entrada ===
+void alert_post(int id) {
+    taskENTER_CRITICAL();
+    mark(id, false);
+    taskEXIT_CRITICAL();
+    xTaskNotify(hConsumer, ALERT_NOTIFY_DUE, eSetBits);
+}
+
+void alert_forget(int id) {
+    taskENTER_CRITICAL();
+    bool found = test(pending_map, id);
+    clear(pending_map, id);
+    for (int i = 0; i < ALERT_SNOOZE_SLOTS; i++) {
+        if (test(snoozes[i].ids, id)) found = true;
+        clear(snoozes[i].ids, id);
+    }
+    if (found) stats.dropped++;
+    taskEXIT_CRITICAL();
+}
+
+// === Grupo da tela ===
+// Maior prioridade primeiro; entre iguais, o disparo mais antigo
+static bool before(const AlertItem* a, const AlertItem* b) {
+    if (a->priority != b->priority) return a->priority > b->priority;
+    return (int32_t)(a->first_ms - b->first_ms) < 0;
+}
+
+static void insert_sorted(AlertItem* group, int len, const AlertItem* item) {
+    int i = len;
+    while (i > 0 && before(item, &group[i - 1])) {
+        group[i] = group[i - 1];
+        i--;
+    }
+    group[i] = *item;
+}
+
+int alert_collect(AlertItem* group, int len, int max) {
+    int added = 0;
+
+    taskENTER_CRITICAL();
+    // Disparos de lembretes que já estão na tela só somam ao item
+    for (int i = 0; i < len; i++) {
+        int id = group[i].id;
+        if (!test(pending_map, id)) continue;
+        clear(pending_map, id);
+        unsigned fired = group[i].fired + pending[id].fired;
+        group[i].fired = fired < UINT8_MAX ? fired : UINT8_MAX;
+        stats.coalesced += pending[id].fired;
+    }
+
+    // Os melhores pendentes até encher o grupo; os demais ficam para a próxima tela
+    AlertItem best[ALERT_MAX_GROUP];
+    int room = max - len < ALERT_MAX_GROUP ? max - len : ALERT_MAX_GROUP;
+    for (int w = 0; w < ID_WORDS && room > 0; w++) {
+        for (uint32_t bits = pending_map[w]; bits; bits &= bits - 1) {
+            int id = w * 32 + __builtin_ctz(bits);
+            const Reminder* r = reminder_get(id);
+            if (!r) {
+                clear(pending_map, id);
+                stats.dropped++;
+                continue;
+            }
+            AlertItem item = {
+                .id = id, .priority = r->priority, .fired = pending[id].fired,
+                .snoozed = pending[id].snoozed, .first_ms = pending[id].first_ms,
+            };
+            if (added < room) insert_sorted(best, added++, &item);
+            else if (before(&item, &best[added - 1])) insert_sorted(best, added - 1, &item);
+        }
+    }
+    for (int i = 0; i < added; i++) {
+        clear(pending_map, best[i].id);
+        memcpy(best[i].name, reminder_get(best[i].id)->name, MAX_NAME_LEN);
+        insert_sorted(group, len++, &best[i]);
+    }
+    stats.shown += added;
+    taskEXIT_CRITICAL();
+
+    if (added) diag_latency_end(DIAG_LAT_ALARM);
+    for (int i = 0; i < added; i++) trace_instant(TRACE_ALERT, best[i].id);
+    return len;
+}
+
+void alert_dismiss(const AlertItem* group, int len, uint32_t snooze_ms) {
+    if (snooze_ms && len > 0) {
+        TickType_t ticks = pdMS_TO_TICKS(snooze_ms);
+
+        taskENTER_CRITICAL();
+        Snooze* s = snooze_slot();
+        for (int i = 0; i < len; i++) {
+            // Um lembrete adiado de novo sai do timer anterior
+            for (int j = 0; j < ALERT_SNOOZE_SLOTS; j++) clear(snoozes[j].ids, group[i].id);
+            if (reminder_get(group[i].id)) {
+                set(s->ids, group[i].id);
+                stats.snoozed++;
+            } else {
+                stats.dropped++;
+            }
+        }
+        // O prazo muda junto com os ids: se o timer de um slot ocupado vencer antes do
+        // xTimerChangePeriod, o callback vê o prazo novo e não entrega os lembretes agora
+        s->busy = true;
+        s->expiry = xTaskGetTickCount() + ticks;
+        taskEXIT_CRITICAL();
+
+        xTimerChangePeriod(s->timer, ticks, portMAX_DELAY);
+    }
+
+    // Pendentes que não couberam na tela atendida
+    taskENTER_CRITICAL();
+    bool more = any(pending_map);
+    taskEXIT_CRITICAL();
+    if (more) xTaskNotify(hConsumer, ALERT_NOTIFY_DUE, eSetBits);
+}
+
+void alert_get_stats(AlertStats* out) {
+    taskENTER_CRITICAL();
+    *out = stats;
+    out->pending = out->snoozing = 0;
+    for (int w = 0; w < ID_WORDS; w++) {
+        out->pending += __builtin_popcount(pending_map[w]);
+        for (int i = 0; i < ALERT_SNOOZE_SLOTS; i++) out->snoozing += __builtin_popcount(snoozes[i].ids[w]);
+    }
+    taskEXIT_CRITICAL();
+}
+
+void alert_init(TaskHandle_t consumer) {
+    hConsumer = consumer;
+    for (int i = 0; i < ALERT_SNOOZE_SLOTS; i++) {
+        snoozes[i].timer = xTimerCreateStatic("snooze", 1, pdFALSE, (void*)(intptr_t)i, snooze_callback,
+                                              &snoozes[i].timer_buf);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef ALERT_H
+#define ALERT_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "reminder.h"
+
+// Lembretes numa mesma tela de alerta; os vencidos além disso esperam a tela seguinte
+#define ALERT_MAX_GROUP 8
+// Adiamentos em curso ao mesmo tempo (um timer cada)
+#define ALERT_SNOOZE_SLOTS 8
+#define ALERT_SNOOZE_MS (5 * 60 * 1000)
+
+// Bit da notificação da tarefa de alerta: há lembretes vencidos esperando
+#define ALERT_NOTIFY_DUE (1u << 0)
+
+typedef struct {
+    uint16_t id;
+    uint8_t priority;
+    uint8_t fired;          // disparos juntados neste alerta (1: só o primeiro)
+    bool snoozed;           // volta de um adiamento
+    uint32_t first_ms;      // tick do primeiro disparo, para a ordem por atraso
+    char name[MAX_NAME_LEN];
+} AlertItem;
+
+typedef struct {
+    uint32_t fired;         // disparos recebidos do agendador e dos adiamentos
+    uint32_t shown;         // lembretes que chegaram a uma tela de alerta
+    uint32_t coalesced;     // disparos juntados a um alerta já pendente ou na tela
+    uint32_t snoozed;
+    uint32_t dropped;       // descartados porque o lembrete foi removido ou alterado
+    uint16_t pending;       // vencidos ainda fora da tela
+    uint16_t snoozing;      // adiados esperando o timer
+} AlertStats;
+
+void alert_init(TaskHandle_t consumer);
+
+// Lembrete vencido (agendador): nunca bloqueia nem descarta; um segundo disparo do mesmo
+// lembrete antes de ele aparecer é juntado ao primeiro
+void alert_post(int id);
+// O lembrete saiu ou mudou: esquece o alerta pendente e o adiamento dele
+void alert_forget(int id);
+
+// Junta ao grupo da tela os pendentes, por prioridade e depois por atraso, até "max" itens;
+// devolve o novo tamanho do grupo
+int alert_collect(AlertItem* group, int len, int max);
+// Tela atendida: com snooze_ms > 0, cada lembrete do grupo volta depois desse tempo
+void alert_dismiss(const AlertItem* group, int len, uint32_t snooze_ms);
+
+void alert_get_stats(AlertStats* out);
+
+#endif
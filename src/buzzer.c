@@ -0,0 +1,126 @@
+// === Buzzer ===
+// O buzzer passivo é tocado pelo PWM: a frequência vem do divisor e do wrap da fatia e o
+// volume do nível do canal. As melodias andam sozinhas num timer do FreeRTOS, cujo callback
+// troca a nota e reprograma o próprio período; a tarefa que pediu o som segue livre para
+// desenhar e atender os botões, e entre as notas nada roda.
+//
+// O timer service tem a maior prioridade e fica no mesmo núcleo da vAlert, que é quem toca:
+// quando buzzer_play e buzzer_stop voltam do xTimerStop, nenhum callback está pela metade.
+#include "FreeRTOS.h"
+#include "timers.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "trace.h"
+#include "buzzer.h"
+
+// === Padrões ===
+static const BuzzerStep alert_urgent_steps[] = {
+    {3136, 120, 100}, {2349, 120, 100}, {3136, 120, 100}, {2349, 120, 100}, {0, 200, 0},
+};
+static const BuzzerMelody alert_urgent = {alert_urgent_steps, count_of(alert_urgent_steps), 0, NULL};
+
+static const BuzzerStep alert_medium_steps[] = {
+    {2637, 100, 60}, {0, 100, 0}, {2637, 100, 60}, {0, 100, 0}, {2637, 100, 60}, {0, 700, 0},
+};
+static const BuzzerMelody alert_medium = {alert_medium_steps, count_of(alert_medium_steps), 8, &alert_urgent};
+
+static const BuzzerStep alert_soft_steps[] = {
+    {2093, 80, 30}, {0, 80, 0}, {2093, 80, 30}, {0, 1760, 0},
+};
+const BuzzerMelody buzzer_alert = {alert_soft_steps, count_of(alert_soft_steps), 5, &alert_medium};
+
+static const BuzzerStep confirm_steps[] = {
+    {2637, 40, 50}, {3520, 60, 50},
+};
+const BuzzerMelody buzzer_confirm = {confirm_steps, count_of(confirm_steps), 1, NULL};
+
+// === Estado ===
+static struct {
+    uint slice, channel;
+    TimerHandle_t timer;
+    StaticTimer_t timer_buf;
+    const BuzzerMelody* melody;     // NULL: parado
+    uint8_t step;
+    uint8_t played;                 // repetições completas da melodia atual
+    bool sounding;
+} bz;
+
+static void tone(uint16_t freq_hz, uint8_t volume) {
+    if (bz.sounding) trace_end(TRACE_BEEP);
+    bz.sounding = freq_hz && volume;
+    if (!bz.sounding) {
+        pwm_set_chan_level(bz.slice, bz.channel, 0);
+        return;
+    }
+
+    if (freq_hz < BUZZER_MIN_HZ) freq_hz = BUZZER_MIN_HZ;
+    if (freq_hz > BUZZER_MAX_HZ) freq_hz = BUZZER_MAX_HZ;
+    if (volume > 100) volume = 100;
+
+    // Menor divisor inteiro com o wrap em 16 bits, para a melhor resolução do nível
+    uint32_t clk = clock_get_hz(clk_sys);
+    uint32_t div = clk / ((uint32_t)freq_hz * 65536) + 1;
+    uint32_t wrap = clk / (div * freq_hz) - 1;
+    pwm_set_clkdiv_int_frac(bz.slice, div, 0);
+    pwm_set_wrap(bz.slice, wrap);
+    pwm_set_chan_level(bz.slice, bz.channel, (wrap + 1) * volume / 200);
+    trace_begin(TRACE_BEEP, freq_hz);
+}
+
+static void start_step(void) {
+    const BuzzerStep* s = &bz.melody->steps[bz.step];
+    tone(s->freq_hz, s->volume);
+    TickType_t ticks = pdMS_TO_TICKS(s->ms);
+    xTimerChangePeriod(bz.timer, ticks ? ticks : 1, 0);
+}
+
+// Fim de um passo: o próximo, a repetição da melodia ou a que vem depois dela
+static void step_callback(TimerHandle_t timer) {
+    if (!bz.melody) return;
+
+    if (++bz.step == bz.melody->count) {
+        bz.step = 0;
+        if (bz.melody->repeat && ++bz.played == bz.melody->repeat) {
+            bz.melody = bz.melody->next;
+            bz.played = 0;
+            if (!bz.melody) {
+                tone(0, 0);
+                return;
+            }
+        }
+    }
+    start_step();
+}
+
+// === API ===
+void buzzer_init(uint pin) {
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    bz.slice = pwm_gpio_to_slice_num(pin);
+    bz.channel = pwm_gpio_to_channel(pin);
+    pwm_config cfg = pwm_get_default_config();
+    pwm_init(bz.slice, &cfg, false);
+    pwm_set_chan_level(bz.slice, bz.channel, 0);
+    pwm_set_enabled(bz.slice, true);
+
+    bz.timer = xTimerCreateStatic("buzzer", 1, pdFALSE, NULL, step_callback, &bz.timer_buf);
+}
+
+void buzzer_play(const BuzzerMelody* melody) {
+    xTimerStop(bz.timer, portMAX_DELAY);
+    bz.melody = melody;
+    bz.step = 0;
+    bz.played = 0;
+    if (melody && melody->count) start_step();
+    else buzzer_stop();
+}
+
+void buzzer_stop(void) {
+    xTimerStop(bz.timer, portMAX_DELAY);
+    bz.melody = NULL;
+    tone(0, 0);
+}
+
+bool buzzer_playing(void) {
+    return bz.melody != NULL;
+}
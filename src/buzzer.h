@@ -0,0 +1,42 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Faixa em que o PWM acerta a frequência com o divisor inteiro (clk_sys de 125 MHz)
+#define BUZZER_MIN_HZ 40
+#define BUZZER_MAX_HZ 20000
+
+// === Sequências ===
+// Cada passo é uma nota (ou pausa, com freq_hz 0) tocada por "ms"; o volume é o ciclo ativo,
+// de 0 a 100 % da metade do período (a onda quadrada simétrica é o máximo do buzzer passivo)
+typedef struct {
+    uint16_t freq_hz;
+    uint16_t ms;
+    uint8_t volume;
+} BuzzerStep;
+
+// A melodia toca "repeat" vezes (0: até buzzer_stop) e segue para "next", o que permite
+// padrões que escalam; sem next, o buzzer silencia no fim
+typedef struct BuzzerMelody {
+    const BuzzerStep* steps;
+    uint8_t count;
+    uint8_t repeat;
+    const struct BuzzerMelody* next;
+} BuzzerMelody;
+
+// Alerta de lembrete: começa discreto e fica mais rápido, agudo e forte a cada ~10 s
+extern const BuzzerMelody buzzer_alert;
+// Confirmação curta (adiar)
+extern const BuzzerMelody buzzer_confirm;
+
+void buzzer_init(uint pin);
+
+// Troca a melodia em curso pela nova, começando já o primeiro passo; não bloqueia
+void buzzer_play(const BuzzerMelody* melody);
+void buzzer_stop(void);
+bool buzzer_playing(void);
+
+#endif
@@ -0,0 +1,160 @@
+// === Relógio de parede ===
+// O RTC guarda a data e a hora; entre leituras, o horário é interpolado pela contagem de ticks,
+// sem acessar periféricos. O RTC só é consultado uma vez por segundo, para conferir se a
+// contagem de ticks não se perdeu. Cada sincronização com o host ajusta a correção de deriva.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "hardware/rtc.h"
+#include "clock.h"
+
+#define CLOCK_DEFAULT_EPOCH 1735689600u     // 2025-01-01 00:00, até a primeira sincronização
+#define CLOCK_MIN_DRIFT_WINDOW_MS (60u * 60u * 1000u)
+#define CLOCK_MAX_DRIFT_PPM 500
+#define CLOCK_RTC_TOLERANCE_MS 2000
+
+static uint64_t anchor_ms;          // horário de parede no instante anchor_tick
+static uint64_t anchor_rtc_ms;      // valor do RTC no mesmo instante (o RTC não recebe a correção de deriva)
+static uint64_t anchor_tick;
+static uint64_t sync_tick;          // tick da última sincronização com o host
+static uint64_t last_rtc_check;
+static int32_t drift_ppm = 0;
+static bool synced = false;
+
+static uint32_t tick_high = 0;
+static TickType_t tick_last = 0;
+
+// === Calendário (algoritmo de dias civis de H. Hinnant) ===
+static int64_t days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int64_t)era * 146097 + doe - 719468;
+}
+
+static void civil_from_days(int64_t z, int* y, int* m, int* d) {
+    z += 719468;
+    int era = (int)((z >= 0 ? z : z - 146096) / 146097);
+    int doe = (int)(z - (int64_t)era * 146097);
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+uint32_t clock_from_fields(int year, int month, int day, int hour, int minute, int second) {
+    return (uint32_t)(days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second);
+}
+
+void clock_to_fields(uint64_t ms, int* year, int* month, int* day, int* hour, int* minute, int* second) {
+    uint32_t s = (uint32_t)(ms / 1000);
+    civil_from_days(s / 86400, year, month, day);
+    *hour = s % 86400 / 3600;
+    *minute = s % 3600 / 60;
+    *second = s % 60;
+}
+
+int clock_weekday(uint64_t ms) {
+    return (int)((ms / MS_PER_DAY + 4) % 7);    // 1970-01-01 foi uma quinta-feira
+}
+
+// === RTC ===
+static void rtc_write(uint32_t epoch_s) {
+    int y, mo, d, h, mi, s;
+    clock_to_fields((uint64_t)epoch_s * 1000, &y, &mo, &d, &h, &mi, &s);
+    datetime_t t = {
+        .year = y, .month = mo, .day = d, .dotw = clock_weekday((uint64_t)epoch_s * 1000),
+        .hour = h, .min = mi, .sec = s
+    };
+    rtc_set_datetime(&t);
+}
+
+static bool rtc_read(uint32_t* epoch_s) {
+    datetime_t t;
+    if (!rtc_get_datetime(&t)) return false;
+    *epoch_s = clock_from_fields(t.year, t.month, t.day, t.hour, t.min, t.sec);
+    return true;
+}
+
+// Contagem de ticks estendida para 64 bits (chamar com a seção crítica tomada)
+static uint64_t ticks64(void) {
+    TickType_t now = xTaskGetTickCount();
+    if (now < tick_last) tick_high++;
+    tick_last = now;
+    return ((uint64_t)tick_high << 32) | now;
+}
+
+static uint64_t ticks_to_ms(uint64_t ticks) {
+    return ticks * 1000 / configTICK_RATE_HZ;
+}
+
+// Horário interpolado a partir da âncora, com a correção de deriva aplicada
+static uint64_t interpolate(uint64_t tick) {
+    int64_t elapsed = (int64_t)ticks_to_ms(tick - anchor_tick);
+    return anchor_ms + elapsed + elapsed * drift_ppm / 1000000;
+}
+
+void clock_init(void) {
+    rtc_init();
+    rtc_write(CLOCK_DEFAULT_EPOCH);
+    anchor_ms = anchor_rtc_ms = (uint64_t)CLOCK_DEFAULT_EPOCH * 1000;
+    anchor_tick = last_rtc_check = 0;
+}
+
+uint64_t clock_now_ms(void) {
+    taskENTER_CRITICAL();
+    uint64_t tick = ticks64();
+    uint64_t now = interpolate(tick);
+    int64_t expected_rtc = (int64_t)(anchor_rtc_ms + ticks_to_ms(tick - anchor_tick));
+    bool check = ticks_to_ms(tick - last_rtc_check) >= 1000;
+    if (check) last_rtc_check = tick;
+    taskEXIT_CRITICAL();
+
+    // Uma vez por segundo, confere com o RTC; se a contagem de ticks perdeu tempo, o RTC prevalece
+    uint32_t rtc_s;
+    if (check && rtc_read(&rtc_s)) {
+        int64_t lost = (int64_t)rtc_s * 1000 - expected_rtc;
+        if (lost > CLOCK_RTC_TOLERANCE_MS || lost < -CLOCK_RTC_TOLERANCE_MS) {
+            taskENTER_CRITICAL();
+            anchor_ms += lost;
+            anchor_rtc_ms += lost;
+            taskEXIT_CRITICAL();
+            now += lost;
+        }
+    }
+    return now;
+}
+
+// Sincronização com o host. A partir da segunda, com pelo menos uma hora de intervalo,
+// o erro acumulado desde a anterior é convertido em correção de deriva (ppm)
+void clock_set(uint32_t epoch_s) {
+    uint64_t target = (uint64_t)epoch_s * 1000;
+
+    taskENTER_CRITICAL();
+    uint64_t tick = ticks64();
+    uint64_t window = ticks_to_ms(tick - sync_tick);
+    if (synced && window >= CLOCK_MIN_DRIFT_WINDOW_MS) {
+        int64_t error = (int64_t)target - (int64_t)interpolate(tick);
+        drift_ppm += (int32_t)(error * 1000000 / (int64_t)window);
+        if (drift_ppm > CLOCK_MAX_DRIFT_PPM) drift_ppm = CLOCK_MAX_DRIFT_PPM;
+        if (drift_ppm < -CLOCK_MAX_DRIFT_PPM) drift_ppm = -CLOCK_MAX_DRIFT_PPM;
+    }
+    anchor_ms = anchor_rtc_ms = target;
+    anchor_tick = sync_tick = last_rtc_check = tick;
+    synced = true;
+    taskEXIT_CRITICAL();
+
+    rtc_write(epoch_s);
+}
+
+bool clock_is_synced(void) {
+    return synced;
+}
+
+int32_t clock_drift_ppm(void) {
+    return drift_ppm;
+}
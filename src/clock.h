@@ -0,0 +1,21 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MS_PER_DAY (24u * 60u * 60u * 1000u)
+
+// Horário de parede local, em ms desde 1970-01-01 00:00
+void clock_init(void);
+uint64_t clock_now_ms(void);
+void clock_set(uint32_t epoch_s);
+bool clock_is_synced(void);
+int32_t clock_drift_ppm(void);
+
+// Conversões de calendário (dia da semana: 0 = domingo)
+uint32_t clock_from_fields(int year, int month, int day, int hour, int minute, int second);
+void clock_to_fields(uint64_t ms, int* year, int* month, int* day, int* hour, int* minute, int* second);
+int clock_weekday(uint64_t ms);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef CORES_H
+#define CORES_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Divisão das tarefas no modo de dois núcleos (cmake -DPROJETO_SMP=ON): a composição e o
+// envio dos quadros ficam no núcleo 1; entrada, agendador, alertas e o timer do FreeRTOS no 0
+#define CORE_CONTROL 0
+#define CORE_DISPLAY 1
+
+// Fixa a tarefa num núcleo; com um núcleo só, não faz nada
+static inline void core_pin(TaskHandle_t task, int core) {
+#if configNUMBER_OF_CORES > 1
+    vTaskCoreAffinitySet(task, 1u << core);
+#else
+    (void)task;
+    (void)core;
+#endif
+}
+
+#endif
@@ -0,0 +1,182 @@
+// === Diagnóstico ===
+// Estatísticas de execução para o shell. O FreeRTOS soma o tempo de cada tarefa lendo o timer
+// de 1 MHz a cada troca de contexto; as filas registradas guardam o pico de ocupação pelo
+// traceQUEUE_SEND. Nada mais é coletado em segundo plano: CPU, taxas do I2C e quadros são
+// calculados quando o shell pede, sobre o intervalo desde o pedido anterior.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "hardware/timer.h"
+#include "inc/ssd1306.h"
+#include "diag.h"
+
+typedef struct {
+    const char* name;
+    QueueHandle_t queue;
+    volatile UBaseType_t peak;
+} Queue;
+
+static Queue queues[DIAG_MAX_QUEUES];
+static int queue_count = 0;
+
+// Tempo de execução das tarefas na leitura anterior, para a CPU do intervalo
+static struct {
+    UBaseType_t number;
+    configRUN_TIME_COUNTER_TYPE time;
+} last_tasks[DIAG_MAX_TASKS];
+static int last_task_count = 0;
+static configRUN_TIME_COUNTER_TYPE last_total = 0;
+
+// Latências: soma, extremos e o início pendente de diag_latency_begin
+static struct {
+    uint32_t count, min_us, max_us;
+    uint64_t sum_us;
+    uint32_t begin_us;
+} latency[DIAG_LAT_COUNT];
+
+static uint64_t last_system_us = 0;
+static struct ssd1306_flush_stats last_flush;
+static struct i2c_bus_stats last_bus;
+
+// Contador do portGET_RUN_TIME_COUNTER_VALUE: o timer de 1 MHz, que não para no sono do tickless
+uint64_t diag_run_time_us(void) {
+    return time_us_64();
+}
+
+// === Filas ===
+void diag_add_queue(const char* name, QueueHandle_t queue) {
+    if (queue_count == DIAG_MAX_QUEUES) return;
+    queues[queue_count] = (Queue){name, queue, 0};
+    vQueueSetQueueNumber(queue, ++queue_count);
+}
+
+// Chamada pelo traceQUEUE_SEND, com a fila travada, antes de a mensagem entrar
+void diag_queue_level(UBaseType_t number, UBaseType_t waiting) {
+    if (number > (UBaseType_t)queue_count) return;
+    Queue* q = &queues[number - 1];
+    if (waiting > q->peak) q->peak = waiting;
+}
+
+int diag_get_queues(DiagQueue* out, int max) {
+    int n = queue_count < max ? queue_count : max;
+    for (int i = 0; i < n; i++) {
+        UBaseType_t waiting = uxQueueMessagesWaiting(queues[i].queue);
+        UBaseType_t length = waiting + uxQueueSpacesAvailable(queues[i].queue);
+        out[i].name = queues[i].name;
+        out[i].waiting = waiting;
+        out[i].length = length;
+        // Um xQueueOverwrite conta uma mensagem a mais do que a fila comporta
+        out[i].peak = queues[i].peak < length ? queues[i].peak : length;
+        uint8_t type = ucQueueGetQueueType(queues[i].queue);
+        out[i].mutex = type == queueQUEUE_TYPE_MUTEX || type == queueQUEUE_TYPE_RECURSIVE_MUTEX;
+    }
+    return n;
+}
+
+// === Latências ===
+void diag_latency_add(DiagLatencyKind kind, uint32_t us) {
+    taskENTER_CRITICAL();
+    if (latency[kind].count == 0 || us < latency[kind].min_us) latency[kind].min_us = us;
+    if (us > latency[kind].max_us) latency[kind].max_us = us;
+    latency[kind].sum_us += us;
+    latency[kind].count++;
+    taskEXIT_CRITICAL();
+}
+
+// Início e fim de uma medida entre duas tarefas; se dois inícios chegam antes do primeiro
+// fim (lembretes no mesmo minuto), os fins seguintes contam a partir do mais recente
+void diag_latency_begin(DiagLatencyKind kind) {
+    latency[kind].begin_us = time_us_32();
+}
+
+void diag_latency_end(DiagLatencyKind kind) {
+    diag_latency_add(kind, time_us_32() - latency[kind].begin_us);
+}
+
+void diag_get_latency(DiagLatencyKind kind, DiagLatency* out) {
+    taskENTER_CRITICAL();
+    out->count = latency[kind].count;
+    out->min_us = latency[kind].min_us;
+    out->max_us = latency[kind].max_us;
+    out->avg_us = latency[kind].count ? (uint32_t)(latency[kind].sum_us / latency[kind].count) : 0;
+    taskEXIT_CRITICAL();
+}
+
+void diag_clear_latency(void) {
+    taskENTER_CRITICAL();
+    for (int i = 0; i < DIAG_LAT_COUNT; i++) {
+        latency[i].count = latency[i].min_us = latency[i].max_us = 0;
+        latency[i].sum_us = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+// === Tarefas ===
+static char state_char(eTaskState state) {
+    switch (state) {
+        case eRunning: return 'X';
+        case eReady: return 'R';
+        case eBlocked: return 'B';
+        case eSuspended: return 'S';
+        default: return 'D';
+    }
+}
+
+int diag_get_tasks(DiagTask* out, int max, uint32_t* window_ms) {
+    static TaskStatus_t status[DIAG_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE total;
+    int n = uxTaskGetSystemState(status, DIAG_MAX_TASKS, &total);
+    configRUN_TIME_COUNTER_TYPE window = total - last_total;
+    // Com dois núcleos, 100% é a capacidade dos dois juntos
+    configRUN_TIME_COUNTER_TYPE capacity = window * configNUMBER_OF_CORES;
+
+    if (n > max) n = max;
+    for (int i = 0; i < n; i++) {
+        // Tarefa criada depois da leitura anterior: conta todo o seu tempo
+        configRUN_TIME_COUNTER_TYPE spent = status[i].ulRunTimeCounter;
+        for (int j = 0; j < last_task_count; j++) {
+            if (last_tasks[j].number == status[i].xTaskNumber) {
+                spent -= last_tasks[j].time;
+                break;
+            }
+        }
+
+        out[i].name = status[i].pcTaskName;
+        out[i].state = state_char(status[i].eCurrentState);
+        out[i].priority = status[i].uxCurrentPriority;
+        out[i].cpu_permille = capacity ? (uint16_t)(spent * 1000 / capacity) : 0;
+        out[i].stack_free = status[i].usStackHighWaterMark * sizeof(StackType_t);
+    }
+
+    for (int i = 0; i < n; i++) {
+        last_tasks[i].number = status[i].xTaskNumber;
+        last_tasks[i].time = status[i].ulRunTimeCounter;
+    }
+    last_task_count = n;
+    last_total = total;
+    *window_ms = (uint32_t)(window / 1000);
+    return n;
+}
+
+// === Sistema ===
+void diag_get_system(DiagSystem* stats) {
+    const struct ssd1306_flush_stats* flush = ssd1306_get_flush_stats();
+    const struct i2c_bus_stats* bus = i2c_bus_get_stats();
+    uint64_t now = time_us_64();
+    uint64_t window_us = now - last_system_us;
+
+    stats->heap_free = xPortGetFreeHeapSize();
+    stats->heap_min = xPortGetMinimumEverFreeHeapSize();
+    stats->window_ms = (uint32_t)(window_us / 1000);
+    stats->i2c_bytes = bus->bytes;
+    stats->i2c_transactions = bus->transactions;
+    stats->frames = flush->frames;
+    stats->i2c_bytes_per_s = (uint32_t)((uint64_t)(bus->bytes - last_bus.bytes) * 1000000 / window_us);
+    stats->i2c_transactions_per_s =
+        (uint32_t)((uint64_t)(bus->transactions - last_bus.transactions) * 1000000 / window_us);
+    stats->frames_per_s = (uint32_t)((uint64_t)(flush->frames - last_flush.frames) * 1000000 / window_us);
+
+    last_flush = *flush;
+    last_bus = *bus;
+    last_system_us = now;
+}
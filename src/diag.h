@@ -0,0 +1,61 @@
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#define DIAG_MAX_TASKS 16
+#define DIAG_MAX_QUEUES 8
+
+typedef struct {
+    const char* name;
+    char state;             // X executando, R pronta, B bloqueada, S suspensa, D apagada
+    uint8_t priority;
+    uint16_t cpu_permille;  // parte da CPU no intervalo desde a leitura anterior
+    uint32_t stack_free;    // menor folga de pilha já vista, em bytes
+} DiagTask;
+
+typedef struct {
+    const char* name;
+    uint16_t waiting, length;
+    uint16_t peak;          // maior ocupação desde o boot
+    bool mutex;             // mutex: "waiting" é 1 quando está livre
+} DiagQueue;
+
+typedef struct {
+    uint32_t heap_free, heap_min;
+    uint32_t window_ms;     // intervalo das taxas, desde a leitura anterior
+    uint32_t i2c_bytes, i2c_transactions, frames;
+    uint32_t i2c_bytes_per_s, i2c_transactions_per_s, frames_per_s;
+} DiagSystem;
+
+// Latências medidas em µs: evento de entrada publicado -> tratado pela vUI, e lembrete
+// disparado pelo agendador -> recebido pela vAlert
+typedef enum {
+    DIAG_LAT_INPUT,
+    DIAG_LAT_ALARM,
+    DIAG_LAT_COUNT
+} DiagLatencyKind;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us, max_us, avg_us;
+} DiagLatency;
+
+// Registra uma fila ou um mutex para o relatório e para o trace; o pico de ocupação é medido
+// pelo traceQUEUE_SEND
+void diag_add_queue(const char* name, QueueHandle_t queue);
+
+void diag_latency_add(DiagLatencyKind kind, uint32_t us);
+void diag_latency_begin(DiagLatencyKind kind);
+void diag_latency_end(DiagLatencyKind kind);
+void diag_get_latency(DiagLatencyKind kind, DiagLatency* out);
+void diag_clear_latency(void);
+
+int diag_get_tasks(DiagTask* tasks, int max, uint32_t* window_ms);
+int diag_get_queues(DiagQueue* queues, int max);
+void diag_get_system(DiagSystem* stats);
+
+#endif
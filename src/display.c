@@ -0,0 +1,169 @@
+// === Servidor do display ===
+// Única tarefa que acessa o framebuffer e o barramento i2c do OLED. As demais tarefas
+// enviam comandos pela fila; os que chegam dentro de um período de quadro geram um só envio.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "inc/ssd1306.h"
+#include "display.h"
+#include "render.h"
+#include "diag.h"
+#include "trace.h"
+#include "cores.h"
+#include <string.h>
+
+static QueueHandle_t qDisplay;
+static SemaphoreHandle_t dispMutex;
+static TaskHandle_t hDisplay;
+
+static StaticQueue_t qDisplay_buf;
+static uint8_t qDisplay_storage[DISPLAY_QUEUE_LEN * sizeof(DisplayCmd)];
+static StaticSemaphore_t dispMutex_buf;
+static StaticTask_t display_tcb;
+static StackType_t display_stack[DISPLAY_STACK_WORDS];
+static bool assembling;         // chegaram comandos de uma tela que ainda não terminou
+static bool list_in_screen;     // a tela em montagem tem a lista
+static bool list_moving;        // a rolagem da lista ainda não chegou ao destino
+
+// Chamado pela interrupção do DMA quando o quadro terminou de ser enviado
+static void on_flush_done(void* ctx) {
+    BaseType_t woken = pdFALSE;
+    trace_end(TRACE_FLUSH);
+    vTaskNotifyGiveFromISR(hDisplay, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Aplica um comando ao framebuffer de trás; retorna true se ele encerra uma tela
+static bool apply(const DisplayCmd* cmd) {
+    assembling = cmd->type != DISPLAY_CMD_SHOW;
+
+    if (cmd->type == DISPLAY_CMD_SHOW) {
+        list_moving = list_moving && list_in_screen;
+        list_in_screen = false;
+        return true;
+    }
+
+    trace_begin(TRACE_RENDER, cmd->type);
+    bool moving = render_command(ssd1306_draw_buffer(), cmd);
+    trace_end(TRACE_RENDER);
+    if (cmd->type == DISPLAY_CMD_LIST) {
+        list_moving = moving;
+        list_in_screen = true;
+    }
+    return false;
+}
+
+static void vDisplay(void* p) {
+    TickType_t next_frame = xTaskGetTickCount();
+    bool ready = false;
+    bool in_flight = false;
+    bool scrolling = false;
+    DisplayCmd cmd;
+
+    // A interrupção do DMA do display vai para o núcleo que o inicializa: o desta tarefa. Se o
+    // display não responder, o driver repete a inicialização a cada quadro
+    ssd1306_init();
+
+    while (1) {
+        // Sem tela pronta, dorme até o próximo comando; com tela pronta (ou a lista rolando),
+        // só até o início do próximo quadro. Com uma tela em montagem, espera o SHOW dela: o
+        // framebuffer de trás já tem parte da tela nova e não pode ser enviado assim
+        TickType_t wait = portMAX_DELAY;
+        if (!assembling && (ready || scrolling)) {
+            TickType_t now = xTaskGetTickCount();
+            wait = (int32_t)(next_frame - now) > 0 ? next_frame - now : 0;
+        }
+
+        if (xQueueReceive(qDisplay, &cmd, wait) == pdTRUE) {
+            if (apply(&cmd)) {
+                ready = true;
+                scrolling = list_moving;
+            }
+            continue;
+        }
+
+        // Cada quadro da rolagem redesenha só a área da lista sobre o quadro anterior
+        if (scrolling && !ready && !assembling) {
+            scrolling = listview_render(ssd1306_draw_buffer());
+            ready = true;
+        }
+
+        if (ready && !assembling) {
+            // O quadro anterior precisa ter saído antes de montar o fluxo do próximo; um barramento
+            // preso não segura a tarefa: depois do prazo, o flush aborta o envio e o recupera
+            if (in_flight) {
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DISPLAY_FLUSH_TIMEOUT_MS));
+            }
+            trace_begin(TRACE_FLUSH, 0);
+            in_flight = ssd1306_flush_async();
+            if (!in_flight) trace_end(TRACE_FLUSH);
+            ready = false;
+            next_frame = xTaskGetTickCount() + pdMS_TO_TICKS(DISPLAY_FRAME_MS);
+        }
+    }
+}
+
+// Origem das linhas da lista; chamada antes da primeira tela com display_list()
+void display_set_list_source(const ListSource* src) {
+    listview_set_source(src);
+}
+
+void display_init(void) {
+    qDisplay = xQueueCreateStatic(DISPLAY_QUEUE_LEN, sizeof(DisplayCmd), qDisplay_storage, &qDisplay_buf);
+    diag_add_queue("Display", qDisplay);
+    dispMutex = xSemaphoreCreateMutexStatic(&dispMutex_buf);
+    diag_add_queue("DisplayLock", dispMutex);
+    hDisplay = xTaskCreateStatic(vDisplay, "Display", DISPLAY_STACK_WORDS, NULL, 2, display_stack, &display_tcb);
+    core_pin(hDisplay, CORE_DISPLAY);
+    ssd1306_set_flush_callback(on_flush_done, NULL);
+}
+
+// === Interface das tarefas clientes ===
+static void send(const DisplayCmd* cmd) {
+    xQueueSend(qDisplay, cmd, portMAX_DELAY);
+}
+
+void display_begin(void) {
+    xSemaphoreTake(dispMutex, portMAX_DELAY);
+}
+
+void display_clear(void) {
+    display_clear_region(0, 0, ssd1306_width, ssd1306_height);
+}
+
+void display_clear_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    DisplayCmd cmd = {.type = DISPLAY_CMD_CLEAR, .x = x, .y = y, .w = w, .h = h};
+    send(&cmd);
+}
+
+void display_text(uint8_t x, uint8_t y, const char* text) {
+    DisplayCmd cmd = {.type = DISPLAY_CMD_TEXT, .x = x, .y = y};
+    strncpy(cmd.text, text, sizeof cmd.text - 1);
+    send(&cmd);
+}
+
+void display_list(int selected) {
+    DisplayCmd cmd = {.type = DISPLAY_CMD_LIST, .arg = selected};
+    send(&cmd);
+}
+
+void display_show(void) {
+    DisplayCmd cmd = {.type = DISPLAY_CMD_SHOW};
+    send(&cmd);
+    xSemaphoreGive(dispMutex);
+}
+
+// Mensagem de duas linhas centralizadas
+void display_message(const char* line1, const char* line2) {
+    int x1 = (ssd1306_width - ssd1306_string_width(line1)) / 2;
+    int x2 = (ssd1306_width - ssd1306_string_width(line2)) / 2;
+    if (x1 < 0) x1 = 0;
+    if (x2 < 0) x2 = 0;
+
+    display_begin();
+    display_clear();
+    display_text(x1, 20, line1);
+    display_text(x2, 40, line2);
+    display_show();
+}
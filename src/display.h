@@ -0,0 +1,44 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "listview.h"
+
+// Período mínimo entre dois envios ao display; comandos recebidos nesse intervalo viram um só flush
+#define DISPLAY_FRAME_MS 50
+// Espera máxima pelo fim de um quadro; o driver aborta e recupera o barramento no próprio prazo
+#define DISPLAY_FLUSH_TIMEOUT_MS 200
+#define DISPLAY_QUEUE_LEN 16
+#define DISPLAY_STACK_WORDS 384
+#define DISPLAY_TEXT_LEN 22
+
+// === Comandos de renderização ===
+typedef enum {
+    DISPLAY_CMD_CLEAR,      // apaga a região (x, y, w, h)
+    DISPLAY_CMD_TEXT,       // desenha o texto em (x, y)
+    DISPLAY_CMD_LIST,       // desenha a lista com a linha "arg" selecionada
+    DISPLAY_CMD_SHOW        // fim de uma tela: o quadro pode ser enviado
+} DisplayCmdType;
+
+typedef struct {
+    uint8_t type;
+    uint8_t x, y, w, h;
+    uint16_t arg;
+    char text[DISPLAY_TEXT_LEN];
+} DisplayCmd;
+
+void display_init(void);
+void display_set_list_source(const ListSource* src);
+
+// Uma tela é montada entre display_begin() e display_show(), sem se misturar com a de outra tarefa
+void display_begin(void);
+void display_clear(void);
+void display_clear_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+void display_text(uint8_t x, uint8_t y, const char* text);
+void display_list(int selected);
+void display_show(void);
+
+void display_message(const char* line1, const char* line2);
+
+#endif
@@ -0,0 +1,268 @@
+// === Entrada por interrupção ===
+// As bordas dos botões disparam a interrupção do GPIO, que só reinicia o timer de debounce.
+// Quando o nível fica estável, o timer publica o evento na fila em que a interface bloqueia.
+// O joystick é amostrado pelo ADC em round-robin, com a FIFO esvaziada por DMA num anel;
+// um timer só lê o anel, filtra e gera os eventos de direção.
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "timers.h"
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "input.h"
+#include "diag.h"
+#include "trace.h"
+
+typedef struct {
+    uint pin;
+    bool pressed;               // último nível estável
+    uint32_t edge_ms;           // primeira borda desde o último evento
+    bool edge_pending;
+    TimerHandle_t debounce;
+    TimerHandle_t long_press;
+    StaticTimer_t debounce_buf, long_press_buf;
+} Button;
+
+typedef struct {
+    uint adc_x, adc_y;
+    int dma;
+    TimerHandle_t timer;
+    StaticTimer_t timer_buf;
+    int32_t x, y;               // valores filtrados, em 1/16 de LSB
+    int8_t held;                // direção atual (0 = centro)
+    uint8_t repeat;
+    uint16_t interval_ms;
+    uint32_t next_ms;
+} Joystick;
+
+static QueueHandle_t qInput;
+static StaticQueue_t qInput_buf;
+static uint8_t qInput_storage[INPUT_QUEUE_LEN * sizeof(InputEvent)];
+static Button buttons[INPUT_MAX_BUTTONS];
+static int n_buttons = 0;
+
+// Anel de 4 amostras escrito pelo DMA: posições pares são o eixo X, ímpares o eixo Y
+static volatile uint16_t adc_ring[4] __attribute__((aligned(8)));
+static Joystick joy = {.dma = -1};
+static JoyRepeat joy_repeat = {.delay_ms = 300, .start_ms = 120, .min_ms = 25, .accel_pct = 15};
+
+static void post_event(InputEvent* ev) {
+    ev->post_us = time_us_32();
+    xQueueSend(qInput, ev, 0);
+}
+
+static void post(uint8_t type, uint8_t button, uint32_t time_ms) {
+    InputEvent ev = {.type = type, .button = button, .time_ms = time_ms};
+    post_event(&ev);
+}
+
+// Interrupção do GPIO: guarda o instante da borda e (re)inicia a janela de debounce
+static void gpio_callback(uint gpio, uint32_t events) {
+    BaseType_t woken = pdFALSE;
+
+    for (int i = 0; i < n_buttons; i++) {
+        Button* b = &buttons[i];
+        if (b->pin != gpio) continue;
+
+        trace_instant(TRACE_BTN_EDGE, gpio);
+        if (!b->edge_pending) {
+            b->edge_ms = to_ms_since_boot(get_absolute_time());
+            b->edge_pending = true;
+        }
+        xTimerResetFromISR(b->debounce, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Fim da janela de debounce: publica o evento se o nível estável mudou
+static void debounce_callback(TimerHandle_t timer) {
+    Button* b = &buttons[(intptr_t)pvTimerGetTimerID(timer)];
+    bool pressed = !gpio_get(b->pin);
+    b->edge_pending = false;
+
+    if (pressed == b->pressed) return;
+    b->pressed = pressed;
+
+    if (pressed) {
+        trace_instant(TRACE_BTN_PRESS, b->pin);
+        post(INPUT_PRESS, b->pin, b->edge_ms);
+        xTimerReset(b->long_press, 0);
+    } else {
+        xTimerStop(b->long_press, 0);
+        post(INPUT_RELEASE, b->pin, b->edge_ms);
+    }
+}
+
+static void long_press_callback(TimerHandle_t timer) {
+    Button* b = &buttons[(intptr_t)pvTimerGetTimerID(timer)];
+    if (b->pressed) {
+        post(INPUT_LONG_PRESS, b->pin, to_ms_since_boot(get_absolute_time()));
+    }
+}
+
+// === Joystick ===
+// Direção com histerese: só muda quando o eixo sai da zona morta e só volta ao centro bem dentro dela
+static int8_t joy_direction(int x, int y, int8_t held) {
+    const int low = INPUT_JOY_DEADZONE;
+    const int high = 4095 - INPUT_JOY_DEADZONE;
+    const int margin = INPUT_JOY_HYSTERESIS;
+
+    if (held != 0) {
+        bool centered = x > low + margin && x < high - margin && y > low + margin && y < high - margin;
+        if (!centered) {
+            // Mantém a direção enquanto o eixo correspondente continua fora do centro
+            if ((held == 1 && y < low + margin) || (held == -1 && y > high - margin) ||
+                (held == 2 && x < low + margin) || (held == -2 && x > high - margin)) {
+                return held;
+            }
+        }
+    }
+
+    if (y < low) return 1;      // cima
+    if (y > high) return -1;    // baixo
+    if (x < low) return 2;      // direita
+    if (x > high) return -2;    // esquerda
+    return 0;
+}
+
+// Timer periódico: média das duas amostras de cada eixo no anel, filtro IIR e auto-repetição
+static void joy_callback(TimerHandle_t timer) {
+    int raw_x = (adc_ring[0] + adc_ring[2]) * 8;
+    int raw_y = (adc_ring[1] + adc_ring[3]) * 8;
+    joy.x += (raw_x - joy.x) / 4;
+    joy.y += (raw_y - joy.y) / 4;
+
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    int8_t dir = joy_direction(joy.x / 16, joy.y / 16, joy.held);
+
+    if (dir != joy.held) {
+        joy.held = dir;
+        joy.repeat = 0;
+        if (dir == 0) return;
+        joy.interval_ms = joy_repeat.start_ms;
+        joy.next_ms = now + joy_repeat.delay_ms;
+    } else if (dir == 0 || (int32_t)(now - joy.next_ms) < 0) {
+        return;
+    } else {
+        if (joy.repeat < UINT8_MAX) joy.repeat++;
+        joy.next_ms = now + joy.interval_ms;
+        joy.interval_ms -= joy.interval_ms * joy_repeat.accel_pct / 100;
+        if (joy.interval_ms < joy_repeat.min_ms) joy.interval_ms = joy_repeat.min_ms;
+    }
+
+    InputEvent ev = {.type = INPUT_JOY, .dir = dir, .repeat = joy.repeat, .time_ms = now};
+    post_event(&ev);
+}
+
+// O RP2040 não tem DMA sem fim: ao fim das UINT32_MAX transferências (49 dias a 1 kHz) o canal é
+// rearmado daqui. Só a contagem é recarregada: o endereço de escrita continua de onde parou no
+// anel, logo depois da última amostra, e a paridade dos eixos se mantém (a contagem é ímpar, o
+// anel não volta ao início)
+static void joy_dma_irq_handler(void) {
+    if (joy.dma < 0 || !dma_channel_get_irq1_status(joy.dma)) return;
+    dma_channel_acknowledge_irq1(joy.dma);
+    dma_channel_set_trans_count(joy.dma, UINT32_MAX, true);
+}
+
+// Os dois eixos precisam estar em canais consecutivos, com X no menor, para a paridade do anel valer
+void input_add_joystick(uint pin_x, uint pin_y) {
+    joy.adc_x = pin_x - 26;
+    joy.adc_y = pin_y - 26;
+    assert(joy.adc_y == joy.adc_x + 1);
+
+    adc_init();
+    adc_gpio_init(pin_x);
+    adc_gpio_init(pin_y);
+    adc_set_round_robin((1u << joy.adc_x) | (1u << joy.adc_y));
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(48000000 / INPUT_JOY_SAMPLE_HZ - 1);
+
+    // A DMA_IRQ_0 é do display, habilitada só no núcleo dele; o joystick fica com a DMA_IRQ_1,
+    // habilitada aqui, no núcleo de controle (init_hw roda nele, antes do escalonador)
+    joy.dma = dma_claim_unused_channel(true);
+    dma_channel_set_irq1_enabled(joy.dma, true);
+    irq_add_shared_handler(DMA_IRQ_1, joy_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    joy.timer = xTimerCreateStatic("joy", pdMS_TO_TICKS(INPUT_JOY_POLL_MS), pdTRUE, NULL, joy_callback, &joy.timer_buf);
+}
+
+void input_set_joy_repeat(const JoyRepeat* cfg) {
+    joy_repeat = *cfg;
+}
+
+// O ADC e o DMA só rodam enquanto alguma tela usa o joystick
+void input_joystick_enable(bool enable) {
+    if (joy.dma < 0) return;
+
+    // adc_run(false) deixa terminar a conversão em andamento: só depois dela a FIFO fica vazia de
+    // vez e o round-robin para. A entrada é escolhida de novo porque ele parou em qualquer eixo
+    adc_run(false);
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) {
+        tight_loop_contents();
+    }
+    dma_channel_set_irq1_enabled(joy.dma, false);
+    dma_channel_abort(joy.dma);
+    dma_channel_acknowledge_irq1(joy.dma);
+    dma_channel_set_irq1_enabled(joy.dma, true);
+    adc_fifo_drain();
+    adc_select_input(joy.adc_x);
+    joy.held = 0;
+
+    if (!enable) {
+        xTimerStop(joy.timer, 0);
+        return;
+    }
+
+    // Recomeça do início do anel, com o eixo X já selecionado, para manter X nas posições pares
+    for (int i = 0; i < 4; i++) {
+        adc_ring[i] = 2048;
+    }
+    joy.x = joy.y = 2048 * 16;
+
+    dma_channel_config config = dma_channel_get_default_config(joy.dma);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, 3);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(joy.dma, &config, adc_ring, &adc_hw->fifo, UINT32_MAX, true);
+
+    adc_run(true);
+    xTimerStart(joy.timer, 0);
+}
+
+void input_init(void) {
+    qInput = xQueueCreateStatic(INPUT_QUEUE_LEN, sizeof(InputEvent), qInput_storage, &qInput_buf);
+    diag_add_queue("Input", qInput);
+}
+
+// Botão ativo em nível baixo, com pull-up interno
+void input_add_button(uint pin) {
+    if (n_buttons >= INPUT_MAX_BUTTONS) return;
+
+    int id = n_buttons;
+    Button* b = &buttons[id];
+    b->pin = pin;
+    b->debounce = xTimerCreateStatic("debounce", pdMS_TO_TICKS(INPUT_DEBOUNCE_MS), pdFALSE, (void*)(intptr_t)id,
+                                     debounce_callback, &b->debounce_buf);
+    b->long_press = xTimerCreateStatic("long", pdMS_TO_TICKS(INPUT_LONG_PRESS_MS), pdFALSE, (void*)(intptr_t)id,
+                                       long_press_callback, &b->long_press_buf);
+
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
+    b->pressed = !gpio_get(pin);
+    n_buttons++;
+
+    gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, gpio_callback);
+}
+
+bool input_wait(InputEvent* ev, TickType_t timeout) {
+    return xQueueReceive(qInput, ev, timeout) == pdTRUE;
+}
+
+void input_post_refresh(void) {
+    post(INPUT_REFRESH, 0, to_ms_since_boot(get_absolute_time()));
+}
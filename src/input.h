@@ -0,0 +1,54 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "FreeRTOS.h"
+#include "pico/stdlib.h"
+
+#define INPUT_QUEUE_LEN 16
+#define INPUT_MAX_BUTTONS 4
+#define INPUT_DEBOUNCE_MS 20
+#define INPUT_LONG_PRESS_MS 800
+
+// Joystick: o ADC alterna entre os dois eixos a 1 kHz e o filtro é lido a cada 10 ms
+#define INPUT_JOY_SAMPLE_HZ 1000
+#define INPUT_JOY_POLL_MS 10
+#define INPUT_JOY_DEADZONE 1000
+#define INPUT_JOY_HYSTERESIS 400
+
+// === Eventos de entrada ===
+typedef enum {
+    INPUT_PRESS,
+    INPUT_RELEASE,
+    INPUT_LONG_PRESS,
+    INPUT_JOY,              // direção do joystick (inicial ou auto-repetição)
+    INPUT_REFRESH           // sem origem física: pede à interface que redesenhe a tela
+} InputType;
+
+typedef struct {
+    uint8_t type;
+    uint8_t button;         // pino do botão
+    int8_t dir;             // joystick: 1 cima, -1 baixo, 2 direita, -2 esquerda
+    uint8_t repeat;         // joystick: 0 no primeiro evento, depois conta as repetições
+    uint32_t time_ms;       // instante da primeira borda, capturado na interrupção
+    uint32_t post_us;       // instante em que entrou na fila (timer de 1 MHz), para a latência
+} InputEvent;
+
+// Auto-repetição com aceleração: após delay_ms, repete a cada start_ms, encurtando
+// o intervalo em accel_pct % a cada repetição até chegar a min_ms
+typedef struct {
+    uint16_t delay_ms;
+    uint16_t start_ms;
+    uint16_t min_ms;
+    uint8_t accel_pct;
+} JoyRepeat;
+
+void input_init(void);
+void input_add_button(uint pin);
+void input_add_joystick(uint pin_x, uint pin_y);
+void input_set_joy_repeat(const JoyRepeat* cfg);
+void input_joystick_enable(bool enable);
+
+bool input_wait(InputEvent* ev, TickType_t timeout);
+void input_post_refresh(void);
+
+#endif
@@ -0,0 +1,193 @@
+// === Importação e exportação de lembretes pela USB ===
+// Quadros binários com tamanho e CRC, chegando pelo mesmo stdio USB do shell, que repassa os
+// bytes de cada quadro para cá. Um quadro leva um lote de registros. Cada registro é gravado
+// com as mesmas funções que o shell e a interface usam, cada uma na sua seção crítica curta.
+// Assim o agendador e a vAlert, de prioridade igual ou maior, não esperam pelo lote. A flash
+// fica com a vStorage, que junta o lote em poucas gravações de página.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "reminder.h"
+#include "input.h"
+#include "link.h"
+#include <string.h>
+
+#define FRAME_SIZE (LINK_HEADER_SIZE + LINK_MAX_PAYLOAD + LINK_CRC_SIZE)
+
+static uint8_t rx[FRAME_SIZE];
+static uint8_t tx[FRAME_SIZE];
+static int rx_len;              // bytes do quadro em recepção; 0 fora de um quadro
+static bool discarding;         // tamanho inválido: ignora tudo até o silêncio
+
+static uint16_t get16(const uint8_t* p) {
+    return p[0] | p[1] << 8;
+}
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+// CRC-16/CCITT (polinômio 0x1021, início 0xFFFF), o mesmo dos registros da flash
+static uint16_t crc16(const uint8_t* p, int len) {
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < len; i++) {
+        crc ^= p[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Sem a tradução de \n para \r\n do stdio, que corromperia o quadro
+static void send(uint8_t type, uint8_t seq, int len) {
+    tx[0] = LINK_SYNC;
+    tx[1] = type;
+    tx[2] = seq;
+    put16(tx + 3, len);
+    put16(tx + LINK_HEADER_SIZE + len, crc16(tx + 1, LINK_HEADER_SIZE - 1 + len));
+    stdio_put_string((const char*)tx, LINK_HEADER_SIZE + len + LINK_CRC_SIZE, false, false);
+    stdio_flush();
+}
+
+static void encode(uint8_t* p, const Reminder* r) {
+    put16(p, r->id);
+    p[2] = r->hour;
+    p[3] = r->minute;
+    p[4] = r->days;
+    p[5] = r->priority;
+    put16(p + 6, r->every_min);
+    memcpy(p + 8, r->name, MAX_NAME_LEN);
+}
+
+// A validação fica com reminder_add e reminder_put
+static void decode(const uint8_t* p, Reminder* r) {
+    memset(r, 0, sizeof *r);
+    r->id = get16(p);
+    r->hour = p[2];
+    r->minute = p[3];
+    r->days = p[4];
+    r->priority = p[5];
+    r->every_min = get16(p + 6);
+    memcpy(r->name, p + 8, MAX_NAME_LEN - 1);
+}
+
+// === Comandos ===
+// Cada um escreve a resposta em "out" e devolve o tamanho dela, ou -LINK_ERR_* se o pedido é inválido
+
+static int hello(const uint8_t* in, int len, uint8_t* out) {
+    (void)in;
+    (void)len;
+    out[0] = LINK_VERSION;
+    out[1] = LINK_BATCH;
+    put16(out + 2, MAX_REMINDERS);
+    put16(out + 4, reminder_count());
+    uint32_t changes = reminder_changes();
+    put16(out + 6, changes);
+    put16(out + 8, changes >> 16);
+    return 10;
+}
+
+// Lembretes por id a partir do pedido, até um lote. O cliente compara o contador de alterações
+// do HELLO antes e depois para saber se a tabela mudou no meio da exportação
+static int export(const uint8_t* in, int len, uint8_t* out) {
+    if (len != 2) return -LINK_ERR_FORMAT;
+
+    int id = get16(in);
+    int n = 0;
+    for (; id < MAX_REMINDERS && n < LINK_BATCH; id++) {
+        Reminder r;
+        if (reminder_copy(id, &r)) encode(out + 3 + n++ * LINK_RECORD_SIZE, &r);
+    }
+    put16(out, id < MAX_REMINDERS ? id : LINK_NO_ID);
+    out[2] = n;
+    return 3 + n * LINK_RECORD_SIZE;
+}
+
+// Registro com id grava naquela posição, substituindo o que houver; LINK_NO_ID ocupa a primeira livre
+static int import(const uint8_t* in, int len, uint8_t* out) {
+    int n = len > 0 ? in[0] : 0;
+    if (len != 1 + n * LINK_RECORD_SIZE || n > LINK_BATCH) return -LINK_ERR_FORMAT;
+
+    out[0] = n;
+    for (int i = 0; i < n; i++) {
+        Reminder r;
+        decode(in + 1 + i * LINK_RECORD_SIZE, &r);
+        int id = r.id == LINK_NO_ID ? reminder_add(&r) : reminder_put(&r);
+        put16(out + 1 + 2 * i, id < 0 ? LINK_NO_ID : id);
+    }
+    // Um redesenho por lote, não por lembrete
+    if (n) input_post_refresh();
+    return 1 + 2 * n;
+}
+
+static int delete(const uint8_t* in, int len, uint8_t* out) {
+    int n = len > 0 ? in[0] : 0;
+    if (len != 1 + 2 * n || n > LINK_BATCH) return -LINK_ERR_FORMAT;
+
+    int removed = 0;
+    for (int i = 0; i < n; i++) {
+        if (reminder_remove(get16(in + 1 + 2 * i))) removed++;
+    }
+    if (removed) input_post_refresh();
+    out[0] = removed;
+    return 1;
+}
+
+static void dispatch(void) {
+    uint8_t type = rx[1];
+    int len = get16(rx + 3);
+    const uint8_t* in = rx + LINK_HEADER_SIZE;
+    uint8_t* out = tx + LINK_HEADER_SIZE;
+    int result;
+
+    switch (type) {
+        case LINK_HELLO: result = hello(in, len, out); break;
+        case LINK_EXPORT: result = export(in, len, out); break;
+        case LINK_IMPORT: result = import(in, len, out); break;
+        case LINK_DELETE: result = delete(in, len, out); break;
+        default: result = -LINK_ERR_TYPE; break;
+    }
+
+    if (result >= 0) {
+        send(type | LINK_REPLY, rx[2], result);
+    } else {
+        out[0] = -result;
+        send(LINK_ERROR, rx[2], 1);
+    }
+}
+
+// === Recepção ===
+bool link_receiving(void) {
+    return rx_len > 0 || discarding;
+}
+
+void link_reset(void) {
+    rx_len = 0;
+    discarding = false;
+}
+
+// Acrescenta um byte ao quadro, que é conferido e atendido quando chega o último
+void link_feed(uint8_t c) {
+    if (discarding) return;
+    rx[rx_len++] = c;
+    if (rx_len < LINK_HEADER_SIZE) return;
+
+    int len = get16(rx + 3);
+    if (len > LINK_MAX_PAYLOAD) {
+        tx[LINK_HEADER_SIZE] = LINK_ERR_LENGTH;
+        send(LINK_ERROR, rx[2], 1);
+        discarding = true;
+        return;
+    }
+    if (rx_len < LINK_HEADER_SIZE + len + LINK_CRC_SIZE) return;
+
+    if (get16(rx + LINK_HEADER_SIZE + len) == crc16(rx + 1, LINK_HEADER_SIZE - 1 + len)) {
+        dispatch();
+    } else {
+        tx[LINK_HEADER_SIZE] = LINK_ERR_CRC;
+        send(LINK_ERROR, rx[2], 1);
+    }
+    rx_len = 0;
+}
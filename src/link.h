@@ -0,0 +1,53 @@
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// === Protocolo binário pela USB ===
+// Quadro, nos dois sentidos, com inteiros little-endian:
+//
+//   LINK_SYNC | tipo | seq | tamanho (u16) | dados | CRC-16/CCITT (u16) do tipo ao fim dos dados
+//
+// A resposta repete a seq do pedido e tem o tipo dele com o bit 7 ligado, ou LINK_ERROR com o
+// código do erro. Um quadro só começa no início de uma linha do shell, e LINK_SYNC não é texto.
+#define LINK_SYNC 0xA5
+#define LINK_VERSION 1
+#define LINK_HEADER_SIZE 5
+#define LINK_CRC_SIZE 2
+#define LINK_REPLY 0x80
+
+// Registro de lembrete: id (u16), hora, minuto, dias, prioridade, every_min (u16) e o nome
+// em 16 bytes terminado em zero
+#define LINK_RECORD_SIZE 24
+// Registros por quadro: cerca de 800 bytes, uma dúzia de pacotes USB
+#define LINK_BATCH 32
+#define LINK_MAX_PAYLOAD (3 + LINK_BATCH * LINK_RECORD_SIZE)
+
+// Silêncio no meio de um quadro que o descarta
+#define LINK_TIMEOUT_MS 500
+// Id de um registro novo na importação (o firmware escolhe a posição), de um recusado na
+// resposta e do fim da exportação
+#define LINK_NO_ID 0xFFFF
+
+enum {
+    LINK_HELLO = 0x01,      // -> versão, lote, capacidade (u16), lembretes (u16), alterações (u32)
+    LINK_EXPORT = 0x02,     // id inicial (u16) -> próximo id (u16), n, registros
+    LINK_IMPORT = 0x03,     // n, registros -> n, id gravado de cada um (u16)
+    LINK_DELETE = 0x04,     // n, ids (u16) -> removidos
+    LINK_ERROR = 0xFF       // -> código
+};
+
+enum {
+    LINK_ERR_CRC = 1,
+    LINK_ERR_LENGTH,        // tamanho acima de LINK_MAX_PAYLOAD: o resto do quadro é ignorado
+    LINK_ERR_TYPE,
+    LINK_ERR_FORMAT
+};
+
+// Usadas só pela tarefa do shell, que lê a USB
+bool link_receiving(void);
+void link_feed(uint8_t c);
+void link_reset(void);
+
+#endif
@@ -0,0 +1,106 @@
+// === Lista com rolagem ===
+// Desenha só as linhas que aparecem na área da lista. Cada linha é rasterizada uma vez numa
+// faixa de 8 pixels de altura (uma página) e guardada num cache indexado pela chave da linha;
+// nos quadros seguintes a faixa é só copiada, deslocada para a posição vertical da rolagem.
+// O custo por quadro depende do número de linhas visíveis, não do tamanho da lista.
+#include "inc/ssd1306.h"
+#include "listview.h"
+#include <string.h>
+
+#define KEY_NONE 0xFFFFFFFFu
+#define TEXT_PAD ((LIST_ROW_H - 8) / 2)
+
+typedef struct {
+    uint32_t key;
+    uint32_t last_used;
+    uint8_t strip[ssd1306_width];
+} RowCache;
+
+static const ListSource* source;
+static RowCache cache[LIST_CACHE_ROWS];
+static uint32_t frame;
+static int selected;
+static int top_px;      // posição atual da rolagem, em pixels
+static int target_px;   // posição para a qual a rolagem está indo
+
+void listview_set_source(const ListSource* src) {
+    source = src;
+    for (int i = 0; i < LIST_CACHE_ROWS; i++) {
+        cache[i].key = KEY_NONE;
+    }
+    selected = top_px = target_px = 0;
+}
+
+// Seleciona a linha "pos" e leva a rolagem até ela ficar inteira na área da lista
+void listview_select(int pos) {
+    int count = source->count();
+    selected = pos < 0 ? 0 : pos >= count ? count - 1 : pos;
+
+    int y = selected * LIST_ROW_H;
+    if (y < target_px) target_px = y;
+    if (y + LIST_ROW_H > target_px + LIST_VIEW_H) target_px = y + LIST_ROW_H - LIST_VIEW_H;
+
+    int max = count * LIST_ROW_H - LIST_VIEW_H;
+    if (target_px > max) target_px = max;
+    if (target_px < 0) target_px = 0;
+}
+
+// Faixa da linha "pos", do cache ou rasterizada agora no lugar da menos usada
+static const uint8_t* row_strip(int pos) {
+    uint32_t key = source->key(pos);
+    RowCache* victim = &cache[0];
+
+    for (int i = 0; i < LIST_CACHE_ROWS; i++) {
+        if (cache[i].key == key) {
+            cache[i].last_used = frame;
+            return cache[i].strip;
+        }
+        if (cache[i].last_used < victim->last_used) victim = &cache[i];
+    }
+
+    char text[ssd1306_width / 8 + 1];
+    source->format(pos, text, sizeof text);
+    memset(victim->strip, 0, sizeof victim->strip);
+    ssd1306_draw_string(victim->strip, 0, 0, text);
+    victim->key = key;
+    victim->last_used = frame;
+    return victim->strip;
+}
+
+// Copia a faixa para a linha que começa em y (pode ser negativo), recortando na área da lista;
+// a linha selecionada vira uma barra invertida da altura da linha
+static void blit_row(uint8_t* buffer, const uint8_t* strip, int y, bool invert) {
+    int base = y >> 3;              // página de cima (arredonda para baixo também se y < 0)
+    int shift = y - base * 8;
+    uint32_t bar = ((1u << LIST_ROW_H) - 1) << shift;
+
+    for (int k = 0; k < (shift + LIST_ROW_H + 7) / 8; k++) {
+        int page = base + k;
+        if (page < 0 || page >= LIST_VIEW_H / 8) continue;
+
+        uint8_t mask = bar >> (8 * k);
+        uint8_t* dst = buffer + page * ssd1306_width;
+        for (int x = 0; x < ssd1306_width; x++) {
+            uint8_t bits = ((uint32_t)strip[x] << (shift + TEXT_PAD)) >> (8 * k);
+            dst[x] = (dst[x] & ~mask) | (invert ? mask & ~bits : mask & bits);
+        }
+    }
+}
+
+// Desenha a área da lista e avança um passo da rolagem; retorna true enquanto ela não chegou ao destino
+bool listview_render(uint8_t* buffer) {
+    frame++;
+
+    // Aproximação suave: metade da distância por quadro, no mínimo um pixel
+    int d = target_px - top_px;
+    top_px += d / 2 ? d / 2 : d;
+
+    memset(buffer, 0, LIST_VIEW_H / 8 * ssd1306_width);
+    int count = source->count();
+    for (int pos = top_px / LIST_ROW_H; pos < count; pos++) {
+        int y = pos * LIST_ROW_H - top_px;
+        if (y >= LIST_VIEW_H) break;
+        blit_row(buffer, row_strip(pos), y, pos == selected);
+    }
+    return top_px != target_px;
+}
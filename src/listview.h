@@ -0,0 +1,25 @@
+#ifndef LISTVIEW_H
+#define LISTVIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Área da lista: as 7 primeiras páginas do display; a última fica para o rodapé
+#define LIST_VIEW_H 56
+#define LIST_ROW_H 12
+#define LIST_CACHE_ROWS 8
+
+// Origem das linhas. "key" identifica o conteúdo da linha e muda quando ela precisa ser
+// redesenhada; "format" só é chamada quando a chave não está no cache.
+typedef struct {
+    int (*count)(void);
+    uint32_t (*key)(int pos);
+    void (*format)(int pos, char* text, int len);
+} ListSource;
+
+// Usadas só pela tarefa do display
+void listview_set_source(const ListSource* src);
+void listview_select(int pos);
+bool listview_render(uint8_t* buffer);
+
+#endif
@@ -8,6 +8,20 @@
 #include "hardware/adc.h"
 #include "hardware/i2c.h"
 #include "inc/ssd1306.h"
+#include "display.h"
+#include "input.h"
+#include "reminder.h"
+#include "scheduler.h"
+#include "clock.h"
+#include "shell.h"
+#include "power.h"
+#include "storage.h"
+#include "diag.h"
+#include "trace.h"
+#include "cores.h"
+#include "buzzer.h"
+#include "alert.h"
+#include "ui.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -18,9 +32,15 @@
 #define BUTTON_B 6
 #define JOY_X 26
 #define JOY_Y 27
-#define DEADZONE 1000
-#define MAX_REMINDERS 5
-#define MAX_NAME_LEN 16
+
+#define UI_STACK_WORDS 512
+#define ALERT_STACK_WORDS 384
+
+// Botões repassados pela vUI à vAlert, nos bits acima do ALERT_NOTIFY_DUE
+#define NOTIFY_BUTTON_A (1u << 1)
+#define NOTIFY_BUTTON_B (1u << 2)
+// Linhas de nomes na tela de alerta com vários lembretes
+#define ALERT_LINES 4
 
 // === Tipos ===
 typedef enum {
@@ -31,253 +51,403 @@ typedef enum {
     MENU_ALERT
 } Menu;
 
+// Regras de repetição oferecidas na tela de inclusão (o botão B alterna entre elas)
 typedef struct {
-    uint8_t hour, minute;
-    char name[MAX_NAME_LEN];
-} Reminder;
+    const char* label;
+    uint8_t days;
+    uint16_t every_min;
+} Rule;
+
+static const Rule rules[] = {
+    {"DIARIO", REMINDER_EVERY_DAY, 0},
+    {"12 EM 12H", REMINDER_EVERY_DAY, 12 * 60},
+    {"8 EM 8H", REMINDER_EVERY_DAY, 8 * 60},
+    {"6 EM 6H", REMINDER_EVERY_DAY, 6 * 60},
+    {"SEG A SEX", REMINDER_WEEKDAYS, 0},
+};
 
 // === Globais ===
-Menu menu = MENU_WAIT_START;
-Reminder reminders[MAX_REMINDERS];
-int count = 0;
-uint8_t sel_hour = 12, sel_min = 0;
-QueueHandle_t qReminders;
-SemaphoreHandle_t dispMutex;
-
-// === Função utilitária de mensagem no display ===
-void display_message(const char* line1, const char* line2) {
-    uint8_t buffer[ssd1306_buffer_length];
-    struct render_area area = {
-        .start_column = 0,
-        .end_column = ssd1306_width - 1,
-        .start_page = 0,
-        .end_page = ssd1306_n_pages - 1
-    };
-    calculate_render_area_buffer_length(&area);
-
-    memset(buffer, 0, sizeof buffer);
-
-    int x1 = (ssd1306_width - strlen(line1) * 6) / 2;
-    int x2 = (ssd1306_width - strlen(line2) * 6) / 2;
-
-    ssd1306_draw_string(buffer, x1, 20, line1);
-    ssd1306_draw_string(buffer, x2, 40, line2);
-
-    render_on_display(buffer, &area);
+volatile Menu menu = MENU_WAIT_START;
+uint8_t sel_hour = 12, sel_min = 0, sel_rule = 0;
+int list_sel = 0;
+TaskHandle_t hAlert;
+
+// === Memória estática ===
+// Tarefas, filas e timers não usam o heap do FreeRTOS: toda a RAM deles aparece no mapa do
+// link (relatório de tools/ram_budget.py). Cada pilha é o pior caminho de chamadas estimado
+// com gcc -fcallgraph-info=su mais margem; a folga real na placa sai no comando tasks
+static StaticTask_t ui_tcb, alert_tcb;
+static StackType_t ui_stack[UI_STACK_WORDS];
+static StackType_t alert_stack[ALERT_STACK_WORDS];
+
+static StaticTask_t idle_tcb[configNUMBER_OF_CORES];
+static StackType_t idle_stack[configNUMBER_OF_CORES][configMINIMAL_STACK_SIZE];
+static StaticTask_t timer_tcb;
+static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+void vApplicationGetIdleTaskMemory(StaticTask_t** tcb, StackType_t** stack, configSTACK_DEPTH_TYPE* words) {
+    *tcb = &idle_tcb[0];
+    *stack = idle_stack[0];
+    *words = configMINIMAL_STACK_SIZE;
 }
 
-// === Funções Display ===
-void disp_menu() {
-    uint8_t buffer[ssd1306_buffer_length];
-    struct render_area area = {0, ssd1306_width - 1, 0, ssd1306_n_pages - 1};
-    calculate_render_area_buffer_length(&area);
-    memset(buffer, 0, sizeof buffer);
-
-    switch(menu) {
-        case MENU_HOME:
-            ssd1306_draw_string(buffer, 5, 5, "LEMBRETES MED");
-            ssd1306_draw_string(buffer, 5, 20, "A ADICIONAR");
-            ssd1306_draw_string(buffer, 5, 35, "B VER LEMBRETES");
-            break;
-
-        case MENU_ADD: {
-            char time[10];
-            snprintf(time, sizeof time, "%02d:%02d", sel_hour, sel_min);
-            ssd1306_draw_string(buffer, 5, 5, "NOVO LEMBRETE");
-            ssd1306_draw_string(buffer, 5, 20, time);
-            ssd1306_draw_string(buffer, 5, 35, "CONFIRME BOTAO A");
-            break;
-        }
+#if configNUMBER_OF_CORES > 1
+// Tarefas ociosas dos demais núcleos
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t** tcb, StackType_t** stack, configSTACK_DEPTH_TYPE* words,
+                                          BaseType_t index) {
+    *tcb = &idle_tcb[index + 1];
+    *stack = idle_stack[index + 1];
+    *words = configMINIMAL_STACK_SIZE;
+}
+#endif
 
-        case MENU_LIST:
-            if (count == 0) {
-                ssd1306_draw_string(buffer, 5, 25, "SEM LEMBRETES");
-            } else {
-                for (int i = 0; i < count && i < 3; i++) {
-                    char line[22];
-                    snprintf(line, sizeof line, "%02d:%02d %s", reminders[i].hour, reminders[i].minute, reminders[i].name);
-                    ssd1306_draw_string(buffer, 0, 10 + i * 15, line);
-                }
-            }
-            ssd1306_draw_string(buffer, 5, 55, "VOLTAR: BOTAO A");
-            break;
-        default:
-            break;
-    }
-    render_on_display(buffer, &area);
+void vApplicationGetTimerTaskMemory(StaticTask_t** tcb, StackType_t** stack, configSTACK_DEPTH_TYPE* words) {
+    *tcb = &timer_tcb;
+    *stack = timer_stack;
+    *words = configTIMER_TASK_STACK_DEPTH;
 }
 
-void disp_alert(const char* name) {
-    uint8_t buffer[ssd1306_buffer_length];
-    struct render_area area = {0, ssd1306_width - 1, 0, ssd1306_n_pages - 1};
-    calculate_render_area_buffer_length(&area);
-    memset(buffer, 0, sizeof buffer);
+#if configCHECK_FOR_STACK_OVERFLOW
+// A pilha da tarefa já passou do fim: nada de FreeRTOS daqui em diante, só a mensagem e a parada
+void vApplicationStackOverflowHook(TaskHandle_t task, char* name) {
+    taskDISABLE_INTERRUPTS();
+    panic("estouro de pilha na tarefa %s\n", name);
+}
+#endif
 
-    char msg[22];
-    snprintf(msg, sizeof msg, "TOMAR: %s", name);
-    ssd1306_draw_string(buffer, 10, 10, "ALERTA!");
-    ssd1306_draw_string(buffer, 10, 30, msg);
-    ssd1306_draw_string(buffer, 10, 50, "A: OK | B: Adiar");
+// === Lista de lembretes ===
+// Linhas na ordem por horário; a chave muda quando o lembrete da posição é trocado ou alterado
+static uint32_t list_key(int pos) {
+    int id = reminder_at(pos);
+    return id < 0 ? 0 : (uint32_t)id << 16 | reminder_revision(id);
+}
 
-    render_on_display(buffer, &area);
+static void list_format(int pos, char* text, int len) {
+    Reminder r;
+    if (reminder_copy(reminder_at(pos), &r)) snprintf(text, len, "%02d:%02d %s", r.hour, r.minute, r.name);
+    else text[0] = '\0';
 }
 
-// === Botões e Joystick ===
-bool btn_press(uint pin) {
-    static uint32_t last[30] = {0};
-    if (!gpio_get(pin)) {
-        uint32_t now = to_ms_since_boot(get_absolute_time());
-        if (now - last[pin] > 200) {
-            last[pin] = now;
-            return true;
-        }
+static const ListSource reminder_list = {reminder_count, list_key, list_format};
+
+// A tela é trocada pela vUI e pela vAlert, que com dois núcleos podem rodar ao mesmo tempo:
+// a troca só vale se a tela ainda é a que quem pediu leu
+static bool menu_change(Menu from, Menu to) {
+    taskENTER_CRITICAL();
+    bool changed = menu == from;
+    if (changed) menu = to;
+    taskEXIT_CRITICAL();
+    return changed;
+}
+
+// === Telas ===
+// Lembretes na tela de alerta; novos disparos entram no grupo enquanto ele está na tela
+static AlertItem group[ALERT_MAX_GROUP];
+static int group_len;
+
+// Rótulo fixo até a borda direita, e linha de mensagem centralizada
+#define TEXT(px, py, str) \
+    {.type = UI_LABEL, .x = px, .y = py, .w = ssd1306_width - (px), .h = 8, .label = {.text = str}}
+#define MESSAGE(py, str) \
+    {.type = UI_LABEL, .flags = UI_CENTER, .y = py, .w = ssd1306_width, .h = 8, .label = {.text = str}}
+#define SCREEN(widgets) {widgets, count_of(widgets)}
+
+static const char* rule_label(int rule) {
+    return rules[rule].label;
+}
+
+// Um lembrete: o nome em destaque
+static uint32_t alert_title_key(void) {
+    return group[0].snoozed;
+}
+
+static void alert_title(char* text, int len) {
+    snprintf(text, len, "%s", group[0].snoozed ? "ALERTA! (ADIADO)" : "ALERTA!");
+}
+
+static uint32_t alert_name_key(void) {
+    return group[0].id;
+}
+
+static void alert_name(char* text, int len) {
+    snprintf(text, len, "TOMAR: %s", group[0].name);
+}
+
+// Vários: um por linha, na ordem do grupo, com "!" nos de prioridade alta; os que não cabem
+// viram um contador
+static uint32_t alert_count_key(void) {
+    return group_len;
+}
+
+static void alert_count(char* text, int len) {
+    snprintf(text, len, "ALERTA! %d LEMBRETES", group_len);
+}
+
+static int alert_lines(void) {
+    return group_len <= ALERT_LINES ? group_len : ALERT_LINES;
+}
+
+static uint32_t alert_lines_key(void) {
+    uint32_t key = group_len;
+    for (int i = 0; i < alert_lines(); i++) key = key * 31 + group[i].id;
+    return key;
+}
+
+static void alert_line(int line, char* text, int len) {
+    int names = group_len <= ALERT_LINES ? group_len : ALERT_LINES - 1;
+    if (line < names) snprintf(text, len, "%c %s", group[line].priority ? '!' : '-', group[line].name);
+    else snprintf(text, len, "+%d OUTROS", group_len - names);
+}
+
+static const UiWidget splash_widgets[] = {
+    MESSAGE(20, "SISTEMA DE"),
+    MESSAGE(40, "LEMBRETES"),
+};
+
+static const UiWidget start_widgets[] = {
+    MESSAGE(20, "PRESSIONE A"),
+    MESSAGE(40, "PARA INICIAR"),
+};
+
+static const UiWidget full_widgets[] = {
+    MESSAGE(20, "SEM ESPACO"),
+    MESSAGE(40, "PARA LEMBRETES"),
+};
+
+static const UiWidget home_widgets[] = {
+    TEXT(5, 5, "LEMBRETES MED"),
+    TEXT(5, 20, "A ADICIONAR"),
+    TEXT(5, 35, "B VER LEMBRETES"),
+};
+
+static const UiWidget add_widgets[] = {
+    TEXT(5, 5, "NOVO LEMBRETE"),
+    {.type = UI_TIME, .x = 5, .y = 20, .w = ssd1306_width - 5, .h = 8,
+     .time = {&sel_hour, &sel_min, &sel_rule, rule_label}},
+    TEXT(0, 35, "A SALVA B REPETE"),
+};
+
+static const UiWidget list_widgets[] = {
+    {.type = UI_LIST, .flags = UI_CENTER, .w = ssd1306_width, .h = LIST_VIEW_H,
+     .list = {&list_sel, reminder_count, reminder_changes, "SEM LEMBRETES"}},
+    TEXT(5, 56, "VOLTAR: BOTAO A"),
+};
+
+static const UiWidget alert_one_widgets[] = {
+    {.type = UI_LABEL, .x = 10, .y = 10, .w = ssd1306_width - 10, .h = 8,
+     .label = {NULL, alert_title_key, alert_title}},
+    {.type = UI_LABEL, .x = 10, .y = 30, .w = ssd1306_width - 10, .h = 8,
+     .label = {NULL, alert_name_key, alert_name}},
+    TEXT(10, 50, "A: OK | B: Adiar"),
+};
+
+static const UiWidget alert_group_widgets[] = {
+    {.type = UI_LABEL, .w = ssd1306_width, .h = 8, .label = {NULL, alert_count_key, alert_count}},
+    {.type = UI_BANNER, .y = 11, .w = ssd1306_width, .h = 50 - 11,
+     .banner = {alert_lines, alert_lines_key, alert_line, 10}},
+    TEXT(10, 50, "A: OK | B: Adiar"),
+};
+
+static const UiScreen splash_screen = SCREEN(splash_widgets);
+static const UiScreen start_screen = SCREEN(start_widgets);
+static const UiScreen full_screen = SCREEN(full_widgets);
+static const UiScreen home_screen = SCREEN(home_widgets);
+static const UiScreen add_screen = SCREEN(add_widgets);
+static const UiScreen list_screen = SCREEN(list_widgets);
+static const UiScreen alert_one_screen = SCREEN(alert_one_widgets);
+static const UiScreen alert_group_screen = SCREEN(alert_group_widgets);
+
+static const UiScreen* menu_screen(Menu m) {
+    switch (m) {
+        case MENU_HOME: return &home_screen;
+        case MENU_ADD: return &add_screen;
+        case MENU_LIST: return &list_screen;
+        case MENU_ALERT: return group_len > 1 ? &alert_group_screen : &alert_one_screen;
+        default: return &start_screen;
     }
-    return false;
 }
 
-int8_t joy_dir() {
-    adc_select_input(0);
-    uint16_t x = adc_read();
-    adc_select_input(1);
-    uint16_t y = adc_read();
-
-    if (y < DEADZONE) return 1;     // cima
-    if (y > 4000) return -1;        // baixo
-    if (x < DEADZONE) return 2;     // direita
-    if (x > 4000) return -2;        // esquerda
-    return 0;
+// Mostra a tela do menu atual, redesenhando só os widgets cujo estado mudou (chamar com o lock
+// da interface: a vAlert não troca o menu entre a leitura e o desenho)
+static void draw_menu(void) {
+    ui_show(menu_screen(menu));
+    ui_refresh();
+}
+
+// Tela de mensagem por "ms"; a tela do menu volta no próximo draw_menu
+static void show_message(const UiScreen* screen, uint32_t ms) {
+    ui_lock();
+    ui_show(screen);
+    ui_refresh();
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(ms));
 }
 
 // === Hardware ===
 void init_hw() {
     stdio_init_all();
-    gpio_init(BUZZER_PIN);
-    gpio_set_dir(BUZZER_PIN, GPIO_OUT);
-    gpio_init(BUTTON_A);
-    gpio_set_dir(BUTTON_A, GPIO_IN);
-    gpio_pull_up(BUTTON_A);
-    gpio_init(BUTTON_B);
-    gpio_set_dir(BUTTON_B, GPIO_IN);
-    gpio_pull_up(BUTTON_B);
-
-    adc_init();
-    adc_gpio_init(JOY_X);
-    adc_gpio_init(JOY_Y);
-
-    i2c_init(i2c1, 100000);
-    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(SDA_PIN);
-    gpio_pull_up(SCL_PIN);
-
-    ssd1306_init();
-}
+    clock_init();
+    power_init();
+    buzzer_init(BUZZER_PIN);
+    input_init();
+    input_add_button(BUTTON_A);
+    input_add_button(BUTTON_B);
+
+    input_add_joystick(JOY_X, JOY_Y);
 
-void beep(uint t) {
-    gpio_put(BUZZER_PIN, 1);
-    vTaskDelay(pdMS_TO_TICKS(t));
-    gpio_put(BUZZER_PIN, 0);
+    i2c_bus_init(i2c1, SDA_PIN, SCL_PIN, ssd1306_i2c_clock * 1000);
 }
 
 // === Tarefas ===
 void vUI(void* p) {
-    TickType_t last = xTaskGetTickCount();
+    show_message(&splash_screen, 2000);
+    ui_lock();
+    draw_menu();
+    ui_unlock();
+
+    InputEvent ev;
+    bool joy_enabled = false;
     while (1) {
-        switch(menu) {
+        // A tarefa dorme até chegar um evento; nada é redesenhado sem ele, e um evento que não
+        // muda o estado de nenhum widget da tela não gera desenho nem envio ao display
+        input_wait(&ev, portMAX_DELAY);
+        if (ev.type != INPUT_REFRESH) diag_latency_add(DIAG_LAT_INPUT, time_us_32() - ev.post_us);
+        bool press_a = ev.type == INPUT_PRESS && ev.button == BUTTON_A;
+        bool press_b = ev.type == INPUT_PRESS && ev.button == BUTTON_B;
+
+        Menu current = menu, next = current;
+        switch(current) {
             case MENU_WAIT_START:
-                display_message("SISTEMA DE", "LEMBRETES");
-                vTaskDelay(pdMS_TO_TICKS(2000));
-                display_message("PRESSIONE A", "PARA INICIAR");
-                while (!btn_press(BUTTON_A)) {
-                    vTaskDelay(pdMS_TO_TICKS(100));
-                }
-                menu = MENU_HOME;
+                if (press_a) next = MENU_HOME;
                 break;
 
             case MENU_HOME:
-                disp_menu();
-                if (btn_press(BUTTON_A)) {
-                    menu = MENU_ADD;
-                } else if (btn_press(BUTTON_B)) {
-                    menu = MENU_LIST;
+                if (press_a) {
+                    // A edição começa no horário atual
+                    int y, mo, d, h, mi, s;
+                    clock_to_fields(clock_now_ms(), &y, &mo, &d, &h, &mi, &s);
+                    sel_hour = h;
+                    sel_min = mi;
+                    sel_rule = 0;
+                    next = MENU_ADD;
+                } else if (press_b) {
+                    list_sel = 0;
+                    next = MENU_LIST;
                 }
                 break;
 
             case MENU_ADD: {
-                int8_t dir = joy_dir();
-                if (dir == 1) sel_hour = (sel_hour + 1) % 24;
-                else if (dir == -1) sel_hour = (sel_hour + 23) % 24;
-                else if (dir == 2) sel_min = (sel_min + 1) % 60;
-                else if (dir == -2) sel_min = (sel_min + 59) % 60;
-
-                if (btn_press(BUTTON_A) && count < MAX_REMINDERS) {
-                    reminders[count++] = (Reminder){sel_hour, sel_min, "MEDICAMENTO"};
-                    menu = MENU_HOME;
+                // Segurando o joystick, os minutos passam a andar de 5 em 5
+                int step = ev.repeat >= 20 ? 5 : 1;
+                if (ev.type == INPUT_JOY) {
+                    if (ev.dir == 1) sel_hour = (sel_hour + 1) % 24;
+                    else if (ev.dir == -1) sel_hour = (sel_hour + 23) % 24;
+                    else if (ev.dir == 2) sel_min = (sel_min + step) % 60;
+                    else if (ev.dir == -2) sel_min = (sel_min + 60 - step) % 60;
+                }
+
+                if (press_b) sel_rule = (sel_rule + 1) % count_of(rules);
+
+                if (press_a) {
+                    Reminder r = {
+                        .hour = sel_hour, .minute = sel_min,
+                        .days = rules[sel_rule].days, .every_min = rules[sel_rule].every_min,
+                        .name = "MEDICAMENTO"
+                    };
+                    if (reminder_add(&r) < 0) show_message(&full_screen, 1000);
+                    next = MENU_HOME;
                 }
-                disp_menu();
                 break;
             }
 
-            case MENU_LIST:
-                disp_menu();
-                if (btn_press(BUTTON_A)) {
-                    menu = MENU_HOME;
-                }
+            case MENU_LIST: {
+                // Segurando o joystick, a seleção passa a andar de 5 em 5 linhas
+                int step = ev.repeat >= 20 ? 5 : 1;
+                if (ev.type == INPUT_JOY && ev.dir == 1) list_sel -= step;
+                else if (ev.type == INPUT_JOY && ev.dir == -1) list_sel += step;
+                if (list_sel >= reminder_count()) list_sel = reminder_count() - 1;
+                if (list_sel < 0) list_sel = 0;
+
+                if (press_a) next = MENU_HOME;
                 break;
+            }
 
             case MENU_ALERT:
-                vTaskDelay(pdMS_TO_TICKS(100));
+                // A tela de alerta é da tarefa vAlert: os botões são repassados a ela
+                if (press_a || press_b) xTaskNotify(hAlert, press_a ? NOTIFY_BUTTON_A : NOTIFY_BUTTON_B, eSetBits);
                 break;
         }
-        vTaskDelayUntil(&last, pdMS_TO_TICKS(100));
+
+        // A vAlert assumiu a tela enquanto o evento era tratado
+        if (next != current && !menu_change(current, next)) continue;
+
+        // O joystick (ADC e DMA) só fica ligado nas telas que o usam
+        bool joy_needed = next == MENU_ADD || next == MENU_LIST;
+        if (joy_enabled != joy_needed) {
+            joy_enabled = joy_needed;
+            input_joystick_enable(joy_enabled);
+        }
+        ui_lock();
+        draw_menu();
+        ui_unlock();
     }
 }
 
 void vAlert(void* p) {
-    Reminder rcv;
+    uint32_t bits;
     while (1) {
-        if (xQueueReceive(qReminders, &rcv, portMAX_DELAY)) {
-            menu = MENU_ALERT;
-            for (int i = 0; i < 5; i++) {
-                beep(100);
-                vTaskDelay(pdMS_TO_TICKS(200));
+        xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+
+        if (bits & ALERT_NOTIFY_DUE) {
+            // O grupo é o estado da tela de alerta: muda com o lock da interface
+            ui_lock();
+            int before = group_len;
+            group_len = alert_collect(group, group_len, ALERT_MAX_GROUP);
+            bool grew = group_len != before;
+            if (grew) {
+                menu = MENU_ALERT;
+                draw_menu();
             }
-            while (1) {
-                disp_alert(rcv.name);
-                if (btn_press(BUTTON_A)) break;
-                if (btn_press(BUTTON_B)) {
-                    rcv.minute += 5;
-                    if (rcv.minute >= 60) {
-                        rcv.minute -= 60;
-                        rcv.hour = (rcv.hour + 1) % 24;
-                    }
-                    xQueueSend(qReminders, &rcv, 0);
-                    break;
-                }
-                vTaskDelay(pdMS_TO_TICKS(100));
+            ui_unlock();
+
+            // A tela sai na hora e o som escala em segundo plano até um dos botões. Um botão de
+            // antes da tela nova não vale para ela: ninguém viu os lembretes que acabaram de entrar
+            if (grew) {
+                if (before == 0) buzzer_play(&buzzer_alert);
+                continue;
             }
-            menu = MENU_HOME;
         }
-    }
-}
 
-void vClock(void* p) {
-    TickType_t last = xTaskGetTickCount();
-    while (1) {
-        vTaskDelayUntil(&last, pdMS_TO_TICKS(60000));
-        for (int i = 0; i < count; i++) {
-            xQueueSend(qReminders, &reminders[i], 0);
+        if (group_len == 0 || !(bits & (NOTIFY_BUTTON_A | NOTIFY_BUTTON_B))) continue;
+        buzzer_stop();
+        if (bits & NOTIFY_BUTTON_B) {
+            buzzer_play(&buzzer_confirm);
+            alert_dismiss(group, group_len, ALERT_SNOOZE_MS);
+        } else {
+            alert_dismiss(group, group_len, 0);
         }
+        ui_lock();
+        group_len = 0;
+        menu_change(MENU_ALERT, MENU_HOME);
+        ui_unlock();
+        input_post_refresh();
     }
 }
 
 int main() {
     init_hw();
-    dispMutex = xSemaphoreCreateMutex();
-    qReminders = xQueueCreate(5, sizeof(Reminder));
-    xTaskCreate(vUI, "UI", 2048, NULL, 3, NULL);
-    xTaskCreate(vAlert, "Alert", 1024, NULL, 2, NULL);
-    xTaskCreate(vClock, "Clock", 1024, NULL, 1, NULL);
+    display_init();
+    display_set_list_source(&reminder_list);
+    ui_init();
+    reminder_init();
+    storage_init();
+    scheduler_init();
+    shell_init();
+    TaskHandle_t hUI = xTaskCreateStatic(vUI, "UI", UI_STACK_WORDS, NULL, 3, ui_stack, &ui_tcb);
+    hAlert = xTaskCreateStatic(vAlert, "Alert", ALERT_STACK_WORDS, NULL, 2, alert_stack, &alert_tcb);
+    alert_init(hAlert);
+    core_pin(hUI, CORE_CONTROL);
+    core_pin(hAlert, CORE_CONTROL);
     vTaskStartScheduler();
     while (1);
 }
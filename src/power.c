@@ -0,0 +1,115 @@
+// === Baixo consumo ===
+// Tickless idle customizado: quando todas as tarefas estão bloqueadas, o SysTick é parado
+// e o núcleo dorme (WFI com SLEEPDEEP) até o próximo prazo do FreeRTOS, programado num
+// alarme do timer, ou até qualquer interrupção (botões, USB, DMA). Na volta, a contagem de
+// ticks é avançada pelo tempo medido no timer de 1 MHz.
+//
+// O modo dormant não é usado: ele para o XOSC e, com ele, o timer e o RTC. Sem um cristal
+// de 32 kHz externo, o RP2040 perderia a hora e não acordaria no prazo de um lembrete.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/systick.h"
+#include "power.h"
+
+// Blocos sem uso neste projeto, desligados enquanto o núcleo dorme
+#define POWER_SLEEP_GATED_EN0 (CLOCKS_SLEEP_EN0_CLK_SYS_PIO0_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PIO1_BITS | \
+                               CLOCKS_SLEEP_EN0_CLK_SYS_I2C0_BITS)
+#define POWER_SLEEP_GATED_EN1 (CLOCKS_SLEEP_EN1_CLK_SYS_SPI0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_SPI0_BITS | \
+                               CLOCKS_SLEEP_EN1_CLK_SYS_SPI1_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_SPI1_BITS | \
+                               CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS | \
+                               CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS)
+
+static int alarm_num = -1;
+static uint32_t us_per_tick;
+static volatile uint32_t wakeups = 0;
+static volatile uint64_t slept_us = 0;
+
+// O alarme só serve para tirar o núcleo do WFI
+static void alarm_callback(uint alarm) {
+}
+
+void power_init(void) {
+    alarm_num = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, alarm_callback);
+    us_per_tick = 1000000 / configTICK_RATE_HZ;
+
+    clocks_hw->sleep_en0 &= ~POWER_SLEEP_GATED_EN0;
+    clocks_hw->sleep_en1 &= ~POWER_SLEEP_GATED_EN1;
+}
+
+// Chamada pelo kernel (portSUPPRESS_TICKS_AND_SLEEP) na tarefa ociosa; o simulador e o modo de
+// dois núcleos rodam sem tickless
+#if configUSE_TICKLESS_IDLE == 2
+static uint32_t carry_us = 0;           // fração de tick ainda não contabilizada
+
+void vApplicationSleep(uint32_t expected_idle) {
+    if (alarm_num < 0) return;
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        restore_interrupts(irq);
+        return;
+    }
+
+    // Para o SysTick, guardando quanto do tick atual já tinha passado
+    uint32_t reload = systick_hw->rvr + 1;
+    uint32_t partial_us = (uint64_t)(reload - systick_hw->cvr) * us_per_tick / reload;
+    systick_hw->csr &= ~M0PLUS_SYST_CSR_ENABLE_BITS;
+
+    uint64_t max_us = (uint64_t)POWER_MAX_SLEEP_MS * 1000;
+    uint64_t sleep_us = (uint64_t)expected_idle * us_per_tick;
+    if (sleep_us > max_us) sleep_us = max_us;
+
+    uint64_t start = time_us_64();
+    bool missed = hardware_alarm_set_target(alarm_num, from_us_since_boot(start + sleep_us - partial_us));
+
+    // Com as interrupções mascaradas, o WFI ainda retorna quando alguma fica pendente
+    if (!missed) {
+        scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+        __wfi();
+        scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+    }
+    hardware_alarm_cancel(alarm_num);
+
+    uint64_t elapsed = time_us_64() - start;
+    uint64_t total = elapsed + partial_us + carry_us;
+    uint64_t ticks = total / us_per_tick;
+    if (ticks >= expected_idle) ticks = expected_idle - 1;
+    carry_us = (uint32_t)(total - ticks * us_per_tick);
+    if (carry_us >= us_per_tick) carry_us = us_per_tick - 1;
+
+    // Reinicia o SysTick do zero e avança a contagem de ticks do kernel
+    systick_hw->cvr = 0;
+    systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+    vTaskStepTick(ticks);
+
+    wakeups++;
+    slept_us += elapsed;
+    restore_interrupts(irq);
+}
+#endif
+
+void power_get_stats(PowerStats* stats) {
+    uint32_t irq = save_and_disable_interrupts();
+    stats->wakeups = wakeups;
+    stats->slept_us = slept_us;
+    restore_interrupts(irq);
+    stats->uptime_us = time_us_64();
+}
+
+uint32_t power_wakeups_per_hour(const PowerStats* stats) {
+    if (stats->uptime_us == 0) return 0;
+    return (uint32_t)((uint64_t)stats->wakeups * 3600000000ull / stats->uptime_us);
+}
+
+// Média ponderada pelo tempo dormindo e acordado
+uint32_t power_estimated_ua(const PowerStats* stats) {
+    if (stats->uptime_us == 0) return POWER_ACTIVE_UA;
+    uint64_t awake_us = stats->uptime_us - stats->slept_us;
+    return (uint32_t)((awake_us * POWER_ACTIVE_UA + stats->slept_us * POWER_SLEEP_UA) / stats->uptime_us);
+}
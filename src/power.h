@@ -0,0 +1,25 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+
+// Estimativas de consumo do RP2040 a 125 MHz (rodando e em sono profundo com clocks
+// desligados); servem para o relatório, não são medidas desta placa
+#define POWER_ACTIVE_UA 24000
+#define POWER_SLEEP_UA 6000
+
+// Maior intervalo de sono de uma vez; o agendador volta a pedir se o prazo for mais longe
+#define POWER_MAX_SLEEP_MS (60u * 60u * 1000u)
+
+typedef struct {
+    uint32_t wakeups;
+    uint64_t slept_us;
+    uint64_t uptime_us;
+} PowerStats;
+
+void power_init(void);
+void power_get_stats(PowerStats* stats);
+uint32_t power_wakeups_per_hour(const PowerStats* stats);
+uint32_t power_estimated_ua(const PowerStats* stats);
+
+#endif
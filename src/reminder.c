@@ -0,0 +1,202 @@
+// === Armazenamento de lembretes ===
+// Os lembretes ocupam posições de um pool fixo, marcadas num mapa de bits de ocupação, sem
+// usar o heap do FreeRTOS. Um índice ordenado por horário serve a listagem; o índice pelo
+// próximo disparo fica no agendador.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "reminder.h"
+#include <string.h>
+
+#define USED_WORDS ((MAX_REMINDERS + 31) / 32)
+
+static Reminder pool[MAX_REMINDERS];
+static uint32_t used[USED_WORDS];       // bit 1 = posição ocupada
+static uint16_t order[MAX_REMINDERS];   // posições ordenadas por horário de início
+static uint16_t revision[MAX_REMINDERS]; // muda a cada alteração da posição
+static uint32_t changes;                // muda a cada alteração de qualquer posição
+static int count = 0;
+static reminder_listener_t listener;
+
+static bool is_used(int id) {
+    return id >= 0 && id < MAX_REMINDERS && (used[id / 32] & (1u << (id % 32)));
+}
+
+static int key(const Reminder* r) {
+    return r->hour * 60 + r->minute;
+}
+
+static bool valid(const Reminder* r) {
+    return r->hour < 24 && r->minute < 60 && (r->days & REMINDER_EVERY_DAY) != 0;
+}
+
+// Primeira posição de "order" cujo horário é maior que k (ou maior ou igual, com "equal")
+static int search(int k, bool equal) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int mk = key(&pool[order[mid]]);
+        if (mk < k || (!equal && mk == k)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Primeira posição livre do pool, ou -1
+static int alloc(void) {
+    for (int w = 0; w < USED_WORDS; w++) {
+        if (~used[w]) {
+            int id = w * 32 + __builtin_ctz(~used[w]);
+            return id < MAX_REMINDERS ? id : -1;
+        }
+    }
+    return -1;
+}
+
+// Grava o lembrete na posição "id" e o coloca no índice por horário (chamar em seção crítica)
+static void insert(int id, const Reminder* r) {
+    used[id / 32] |= 1u << (id % 32);
+    revision[id]++;
+    changes++;
+    pool[id] = *r;
+    pool[id].id = id;
+    pool[id].days &= REMINDER_EVERY_DAY;
+    if (pool[id].priority > REMINDER_MAX_PRIORITY) pool[id].priority = REMINDER_MAX_PRIORITY;
+    pool[id].name[MAX_NAME_LEN - 1] = '\0';
+
+    int pos = search(key(r), false);
+    memmove(&order[pos + 1], &order[pos], (count - pos) * sizeof order[0]);
+    order[pos] = id;
+    count++;
+}
+
+// Tira o lembrete "id" do índice por horário e libera a posição (chamar em seção crítica)
+static void erase(int id) {
+    int pos = search(key(&pool[id]), true);
+    while (order[pos] != id) pos++;
+    memmove(&order[pos], &order[pos + 1], (count - pos - 1) * sizeof order[0]);
+    count--;
+    used[id / 32] &= ~(1u << (id % 32));
+    revision[id]++;
+    changes++;
+}
+
+static void changed(int id) {
+    scheduler_add(id);
+    if (listener) listener(id);
+}
+
+void reminder_init(void) {
+    memset(used, 0, sizeof used);
+    count = 0;
+}
+
+// Chamada depois de cada inclusão, alteração ou remoção, no contexto de quem fez a mudança
+void reminder_set_listener(reminder_listener_t fn) {
+    listener = fn;
+}
+
+// Copia o lembrete para o pool e o agenda; devolve o id, ou -1 se a regra é inválida ou o pool está cheio
+int reminder_add(const Reminder* r) {
+    if (!valid(r)) return -1;
+
+    taskENTER_CRITICAL();
+    int id = alloc();
+    if (id >= 0) insert(id, r);
+    taskEXIT_CRITICAL();
+
+    if (id >= 0) changed(id);
+    return id;
+}
+
+// Grava o lembrete na posição r->id, substituindo o que estiver lá (restauração e importação)
+int reminder_put(const Reminder* r) {
+    int id = r->id;
+    if (!valid(r) || id >= MAX_REMINDERS) return -1;
+    scheduler_remove(id);
+
+    taskENTER_CRITICAL();
+    if (is_used(id)) erase(id);
+    insert(id, r);
+    taskEXIT_CRITICAL();
+
+    changed(id);
+    return id;
+}
+
+bool reminder_remove(int id) {
+    if (id < 0 || id >= MAX_REMINDERS) return false;
+    scheduler_remove(id);
+
+    taskENTER_CRITICAL();
+    bool found = is_used(id);
+    if (found) erase(id);
+    taskEXIT_CRITICAL();
+
+    if (found && listener) listener(id);
+    return found;
+}
+
+// Lembrete com o id dado, ou NULL; o ponteiro vale até o lembrete ser removido
+const Reminder* reminder_get(int id) {
+    return is_used(id) ? &pool[id] : NULL;
+}
+
+// Cópia do lembrete feita com o pool travado, ou false se a posição está livre. Para ler fora
+// de seção crítica: com dois núcleos, o ponteiro de reminder_get pode mudar no meio da leitura
+bool reminder_copy(int id, Reminder* out) {
+    taskENTER_CRITICAL();
+    const Reminder* r = reminder_get(id);
+    if (r) *out = *r;
+    taskEXIT_CRITICAL();
+    return r != NULL;
+}
+
+// Contador de alterações do lembrete "id", para quem guarda algo derivado dele
+uint16_t reminder_revision(int id) {
+    return revision[id];
+}
+
+// Contador de alterações do conjunto, para quem guarda algo derivado da listagem
+uint32_t reminder_changes(void) {
+    return changes;
+}
+
+int reminder_count(void) {
+    return count;
+}
+
+// Id do lembrete na posição "pos" da listagem por horário, ou -1
+int reminder_at(int pos) {
+    taskENTER_CRITICAL();
+    int id = pos >= 0 && pos < count ? order[pos] : -1;
+    taskEXIT_CRITICAL();
+    return id;
+}
+
+// Próxima ocorrência (estritamente depois de "after"), em tempo constante
+uint64_t reminder_next(const Reminder* r, uint64_t after) {
+    uint64_t start = (r->hour * 60u + r->minute) * 60u * 1000u;
+    uint64_t day = after - after % MS_PER_DAY;
+    uint64_t t = after % MS_PER_DAY;
+    int wd = clock_weekday(after);
+
+    // Com repetição, os horários do dia são start mod step e seus múltiplos de step, antes e
+    // depois de hour:minute: "8 em 8h" criado às 14:00 toca às 06:00, 14:00 e 22:00
+    uint64_t step = r->every_min * 60u * 1000u;
+    if (step) start %= step;
+
+    // Ainda há um horário hoje?
+    if (r->days & (1u << wd)) {
+        if (t < start) return day + start;
+        if (step) {
+            uint64_t due = start + ((t - start) / step + 1) * step;
+            if (due < MS_PER_DAY) return day + due;
+        }
+    }
+
+    // Próximo dia marcado: a máscara duplicada e deslocada põe amanhã no bit 0
+    uint32_t ahead = ((uint32_t)r->days | (uint32_t)r->days << 7) >> (wd + 1);
+    return day + (uint64_t)(__builtin_ctz(ahead) + 1) * MS_PER_DAY + start;
+}
@@ -0,0 +1,45 @@
+#ifndef REMINDER_H
+#define REMINDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAX_REMINDERS 256
+#define MAX_NAME_LEN 16
+
+// Dias da semana da regra de repetição (bit 0 = domingo)
+#define REMINDER_EVERY_DAY 0x7F
+#define REMINDER_WEEKDAYS 0x3E
+
+// Prioridade do alerta: numa tela com vários lembretes, os de maior prioridade vêm primeiro
+#define REMINDER_MAX_PRIORITY 3
+
+// Regra de repetição: nos dias marcados em "days", às hour:minute (every_min = 0: uma vez por
+// dia) ou a cada "every_min" minutos alinhados a hour:minute, da meia-noite ao fim do dia. A
+// grade recomeça a cada dia marcado: um passo que não divide 24h encurta o último intervalo
+// antes da meia-noite
+typedef struct {
+    uint8_t hour, minute;
+    uint8_t days;
+    uint8_t priority;       // 0 a REMINDER_MAX_PRIORITY; ocupa o byte de alinhamento, o registro na flash não muda
+    uint16_t every_min;
+    uint16_t id;            // posição no pool, preenchida pelo armazenamento
+    char name[MAX_NAME_LEN];
+} Reminder;
+
+typedef void (*reminder_listener_t)(int id);
+
+void reminder_init(void);
+void reminder_set_listener(reminder_listener_t fn);
+int reminder_add(const Reminder* r);
+int reminder_put(const Reminder* r);
+bool reminder_remove(int id);
+const Reminder* reminder_get(int id);
+bool reminder_copy(int id, Reminder* out);
+uint16_t reminder_revision(int id);
+uint32_t reminder_changes(void);
+int reminder_count(void);
+int reminder_at(int pos);
+uint64_t reminder_next(const Reminder* r, uint64_t after);
+
+#endif
@@ -0,0 +1,27 @@
+// === Rasterização dos comandos de tela ===
+// Traduz os comandos que as tarefas enviam ao display em pixels do framebuffer. Não depende
+// do FreeRTOS, então os benchmarks compõem as mesmas telas fora da tarefa do display.
+#include "inc/ssd1306.h"
+#include "render.h"
+
+// Apaga os pixels da região, limitada ao tamanho do display
+void render_clear(uint8_t* buffer, int x, int y, int w, int h) {
+    ssd1306_fill_rect(buffer, x, y, w, h, false);
+}
+
+bool render_command(uint8_t* buffer, const DisplayCmd* cmd) {
+    switch (cmd->type) {
+        case DISPLAY_CMD_CLEAR:
+            render_clear(buffer, cmd->x, cmd->y, cmd->w, cmd->h);
+            break;
+        case DISPLAY_CMD_TEXT:
+            ssd1306_draw_string(buffer, cmd->x, cmd->y, (char*)cmd->text);
+            break;
+        case DISPLAY_CMD_LIST:
+            listview_select(cmd->arg);
+            return listview_render(buffer);
+        default:
+            break;
+    }
+    return false;
+}
@@ -0,0 +1,14 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+
+// Rasterização dos comandos de tela, sem FreeRTOS: usada pelo servidor do display e pelos benchmarks
+void render_clear(uint8_t* buffer, int x, int y, int w, int h);
+
+// Aplica o comando ao framebuffer; retorna true se é uma lista cuja rolagem ainda não chegou ao destino
+bool render_command(uint8_t* buffer, const DisplayCmd* cmd);
+
+#endif
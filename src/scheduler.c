@@ -0,0 +1,152 @@
+// === Agendador de lembretes ===
+// Mantém um heap mínimo com o próximo horário absoluto de cada lembrete e dorme até o
+// primeiro deles. Só os lembretes vencidos são disparados, e cada disparo, inclusão ou
+// remoção custa O(log n). Os disparos vão para o despacho de alertas, que nunca bloqueia.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "cores.h"
+#include "diag.h"
+#include "alert.h"
+
+typedef struct {
+    uint64_t due_ms;
+    uint16_t id;
+} Entry;
+
+static Entry heap[MAX_REMINDERS];
+static uint16_t heap_pos[MAX_REMINDERS];    // posição de cada lembrete no heap mais 1, ou 0 se fora dele
+static int heap_size = 0;
+static TaskHandle_t hScheduler;
+static StaticTask_t scheduler_tcb;
+static StackType_t scheduler_stack[SCHEDULER_STACK_WORDS];
+
+static uint64_t now_ms(void) {
+    return clock_now_ms();
+}
+
+// === Heap mínimo por horário ===
+static void place(int i, Entry e) {
+    heap[i] = e;
+    heap_pos[e.id] = i + 1;
+}
+
+static void sift_up(int i) {
+    Entry e = heap[i];
+    while (i > 0 && heap[(i - 1) / 2].due_ms > e.due_ms) {
+        place(i, heap[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    place(i, e);
+}
+
+static void sift_down(int i) {
+    Entry e = heap[i];
+    while (1) {
+        int l = 2 * i + 1, r = l + 1, m = l;
+        if (l >= heap_size) break;
+        if (r < heap_size && heap[r].due_ms < heap[l].due_ms) m = r;
+        if (heap[m].due_ms >= e.due_ms) break;
+        place(i, heap[m]);
+        i = m;
+    }
+    place(i, e);
+}
+
+static void heap_push(Entry e) {
+    place(heap_size++, e);
+    sift_up(heap_size - 1);
+}
+
+static void heap_remove(int i) {
+    heap_pos[heap[i].id] = 0;
+    if (--heap_size == i) return;
+    place(i, heap[heap_size]);
+    if (i > 0 && heap[(i - 1) / 2].due_ms > heap[i].due_ms) sift_up(i);
+    else sift_down(i);
+}
+
+// Horário do próximo disparo, ou UINT64_MAX se não há lembretes
+uint64_t scheduler_next_due(void) {
+    taskENTER_CRITICAL();
+    uint64_t due = heap_size > 0 ? heap[0].due_ms : UINT64_MAX;
+    taskEXIT_CRITICAL();
+    return due;
+}
+
+// Agenda o lembrete "id" do armazenamento e acorda o agendador para recalcular a espera
+void scheduler_add(int id) {
+    uint64_t now = now_ms();
+
+    taskENTER_CRITICAL();
+    const Reminder* r = reminder_get(id);
+    if (r && !heap_pos[id]) heap_push((Entry){reminder_next(r, now), id});
+    taskEXIT_CRITICAL();
+    if (hScheduler) xTaskNotifyGive(hScheduler);
+}
+
+// Também descarta o alerta ainda não atendido e o adiamento do lembrete, que deixou de valer
+void scheduler_remove(int id) {
+    taskENTER_CRITICAL();
+    if (heap_pos[id]) heap_remove(heap_pos[id] - 1);
+    taskEXIT_CRITICAL();
+    alert_forget(id);
+    if (hScheduler) xTaskNotifyGive(hScheduler);
+}
+
+// O relógio foi acertado: recalcula o próximo horário de todos os lembretes e refaz o heap em O(n)
+void scheduler_time_changed(void) {
+    uint64_t now = now_ms();
+
+    taskENTER_CRITICAL();
+    for (int i = 0; i < heap_size; i++) {
+        heap[i].due_ms = reminder_next(reminder_get(heap[i].id), now);
+    }
+    for (int i = heap_size / 2 - 1; i >= 0; i--) {
+        sift_down(i);
+    }
+    taskEXIT_CRITICAL();
+    if (hScheduler) xTaskNotifyGive(hScheduler);
+}
+
+static void vScheduler(void* p) {
+    while (1) {
+        uint64_t due = scheduler_next_due();
+        uint64_t now = now_ms();
+
+        if (due > now) {
+            // Dorme até o próximo horário; um lembrete novo interrompe a espera
+            TickType_t wait = portMAX_DELAY;
+            if (due != UINT64_MAX) {
+                uint64_t ticks = (due - now) * configTICK_RATE_HZ / 1000 + 1;
+                wait = ticks < portMAX_DELAY ? (TickType_t)ticks : portMAX_DELAY - 1;
+            }
+            ulTaskNotifyTake(pdTRUE, wait);
+            continue;
+        }
+
+        // Dispara todos os vencidos e reagenda cada um para a próxima ocorrência da regra
+        while (1) {
+            int id = -1;
+            taskENTER_CRITICAL();
+            if (heap_size > 0 && heap[0].due_ms <= now) {
+                id = heap[0].id;
+                heap[0].due_ms = reminder_next(reminder_get(id), heap[0].due_ms);
+                sift_down(0);
+            }
+            taskEXIT_CRITICAL();
+            if (id < 0) break;
+
+            diag_latency_begin(DIAG_LAT_ALARM);
+            alert_post(id);
+        }
+    }
+}
+
+void scheduler_init(void) {
+    hScheduler = xTaskCreateStatic(vScheduler, "Scheduler", SCHEDULER_STACK_WORDS, NULL, 1, scheduler_stack,
+                                   &scheduler_tcb);
+    core_pin(hScheduler, CORE_CONTROL);
+}
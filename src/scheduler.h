@@ -0,0 +1,15 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "FreeRTOS.h"
+#include "reminder.h"
+
+#define SCHEDULER_STACK_WORDS 256
+
+void scheduler_init(void);
+void scheduler_add(int id);
+void scheduler_remove(int id);
+void scheduler_time_changed(void);
+uint64_t scheduler_next_due(void);
+
+#endif
@@ -0,0 +1,374 @@
+// === Shell serial (USB CDC) ===
+// Lê linhas do stdio USB e executa comandos simples. A tarefa só acorda quando chegam
+// caracteres (callback do stdio), então não consome CPU enquanto ninguém está conectado.
+// Os quadros do protocolo binário de importação e exportação (link.c) chegam pelo mesmo
+// stdio e são separados das linhas pelo byte inicial.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "power.h"
+#include "reminder.h"
+#include "storage.h"
+#include "input.h"
+#include "diag.h"
+#include "trace.h"
+#include "alert.h"
+#include "ui.h"
+#include "link.h"
+#include "inc/i2c_bus.h"
+#include "shell.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static TaskHandle_t hShell;
+static StaticTask_t shell_tcb;
+static StackType_t shell_stack[SHELL_STACK_WORDS];
+
+// === Comandos ===
+static void cmd_help(int argc, char** argv);
+
+// 2024-01-01 00:00: um horário anterior só pode ser erro de digitação, e levaria o relógio para
+// antes dos lembretes do dia
+#define TIME_MIN_EPOCH 1704067200UL
+
+// Epoch de "time <epoch>" ou "time AAAA-MM-DD HH:MM[:SS]"; 0 se o argumento é inválido
+static uint32_t time_parse(int argc, char** argv) {
+    if (argc == 2) {
+        char* end;
+        unsigned long epoch = strtoul(argv[1], &end, 10);
+        return end != argv[1] && *end == '\0' && epoch >= TIME_MIN_EPOCH && epoch <= UINT32_MAX ? epoch : 0;
+    }
+
+    int y, mo, d, h, mi, s = 0;
+    if (sscanf(argv[1], "%d-%d-%d", &y, &mo, &d) != 3 || sscanf(argv[2], "%d:%d:%d", &h, &mi, &s) < 2) return 0;
+    if (y < 2024 || mo < 1 || mo > 12 || d < 1 || d > 31) return 0;
+    if (h < 0 || h > 23 || mi < 0 || mi > 59 || s < 0 || s > 59) return 0;
+    return clock_from_fields(y, mo, d, h, mi, s);
+}
+
+// time                         mostra o horário atual
+// time <epoch>                 acerta pelo número de segundos desde 1970 (horário local)
+// time AAAA-MM-DD HH:MM[:SS]   acerta pela data e hora
+static void cmd_time(int argc, char** argv) {
+    int y, mo, d, h, mi, s;
+
+    if (argc > 1) {
+        uint32_t epoch = argc <= 3 ? time_parse(argc, argv) : 0;
+        if (!epoch) {
+            printf("uso: time [epoch | AAAA-MM-DD HH:MM[:SS]]\n");
+            return;
+        }
+        clock_set(epoch);
+        scheduler_time_changed();
+    }
+
+    clock_to_fields(clock_now_ms(), &y, &mo, &d, &h, &mi, &s);
+    printf("%04d-%02d-%02d %02d:%02d:%02d %s, deriva %ld ppm\n", y, mo, d, h, mi, s,
+           clock_is_synced() ? "sincronizado" : "nao sincronizado", (long)clock_drift_ppm());
+}
+
+// power                        acordadas por hora, fração do tempo dormindo e consumo estimado
+static void cmd_power(int argc, char** argv) {
+    PowerStats stats;
+    power_get_stats(&stats);
+
+    uint32_t sleep_pct = stats.uptime_us ? (uint32_t)(stats.slept_us * 1000 / stats.uptime_us) : 0;
+    printf("acordadas: %lu (%lu/h)\n", (unsigned long)stats.wakeups, (unsigned long)power_wakeups_per_hour(&stats));
+    printf("dormindo: %lu.%lu%% de %llu s\n", (unsigned long)sleep_pct / 10, (unsigned long)sleep_pct % 10,
+           (unsigned long long)(stats.uptime_us / 1000000));
+    printf("consumo estimado: %lu uA\n", (unsigned long)power_estimated_ua(&stats));
+}
+
+// === Lembretes ===
+static const char* const day_names[7] = {"dom", "seg", "ter", "qua", "qui", "sex", "sab"};
+
+// Dias no formato "seg,qua,sex", "todos" ou "uteis"; 0 se algum nome é inválido
+static uint8_t parse_days(char* arg) {
+    if (strcmp(arg, "todos") == 0) return REMINDER_EVERY_DAY;
+    if (strcmp(arg, "uteis") == 0) return REMINDER_WEEKDAYS;
+
+    uint8_t days = 0;
+    for (char* save = NULL, *tok = strtok_r(arg, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        int d = 0;
+        while (d < 7 && strcmp(tok, day_names[d]) != 0) d++;
+        if (d == 7) return 0;
+        days |= 1u << d;
+    }
+    return days;
+}
+
+// list                         lembretes por horário, com a regra e o próximo disparo
+static void cmd_list(int argc, char** argv) {
+    uint64_t now = clock_now_ms();
+
+    for (int i = 0; i < reminder_count(); i++) {
+        Reminder copy;
+        if (!reminder_copy(reminder_at(i), &copy)) break;
+        const Reminder* r = &copy;
+
+        char days[32] = "todos";
+        if (r->days != REMINDER_EVERY_DAY) {
+            days[0] = '\0';
+            for (int d = 0; d < 7; d++) {
+                if (!(r->days & (1u << d))) continue;
+                if (days[0]) strcat(days, ",");
+                strcat(days, day_names[d]);
+            }
+        }
+
+        int y, mo, dd, h, mi, s;
+        clock_to_fields(reminder_next(r, now), &y, &mo, &dd, &h, &mi, &s);
+        printf("%3u %02u:%02u cada %4u min %-27s p%u %-15s prox %02d/%02d %02d:%02d\n", r->id, r->hour, r->minute,
+               r->every_min, days, r->priority, r->name, dd, mo, h, mi);
+    }
+    printf("%d de %d lembretes\n", reminder_count(), MAX_REMINDERS);
+}
+
+// add HH:MM NOME [cada N(h|m)] [dias seg,qua,... | todos | uteis] [prio 0-3]
+static void cmd_add(int argc, char** argv) {
+    Reminder r = {.days = REMINDER_EVERY_DAY};
+    unsigned h, mi;
+    bool ok = argc >= 3 && sscanf(argv[1], "%u:%u", &h, &mi) == 2 && h < 24 && mi < 60;
+
+    for (int i = 3; ok && i + 1 < argc; i += 2) {
+        char* unit;
+        if (strcmp(argv[i], "cada") == 0) {
+            unsigned long n = strtoul(argv[i + 1], &unit, 10);
+            ok = n > 0 && unit[0] != '\0' && unit[1] == '\0' &&
+                 ((*unit == 'h' && n < 24) || (*unit == 'm' && n < 24 * 60));
+            r.every_min = ok && *unit == 'h' ? n * 60 : n;
+        } else if (strcmp(argv[i], "dias") == 0) {
+            r.days = parse_days(argv[i + 1]);
+        } else if (strcmp(argv[i], "prio") == 0) {
+            unsigned long n = strtoul(argv[i + 1], &unit, 10);
+            ok = *unit == '\0' && n <= REMINDER_MAX_PRIORITY;
+            r.priority = n;
+        } else {
+            ok = false;
+        }
+    }
+    if (!ok || argc % 2 == 0) {
+        printf("uso: add HH:MM NOME [cada N(h|m)] [dias seg,qua,... | todos | uteis] [prio 0-%d]\n",
+               REMINDER_MAX_PRIORITY);
+        return;
+    }
+
+    r.hour = h;
+    r.minute = mi;
+    strncpy(r.name, argv[2], MAX_NAME_LEN - 1);
+    int id = reminder_add(&r);
+    if (id < 0) printf("regra invalida ou sem espaco\n");
+    else printf("lembrete %d adicionado\n", id);
+    input_post_refresh();
+}
+
+// del ID
+static void cmd_del(int argc, char** argv) {
+    char* end = NULL;
+    long id = argc == 2 ? strtol(argv[1], &end, 10) : -1;
+    if (argc != 2 || end == argv[1] || *end != '\0' || id < 0 || id >= MAX_REMINDERS || !reminder_remove(id)) {
+        printf("uso: del ID (ids no comando list)\n");
+        return;
+    }
+    input_post_refresh();
+}
+
+// storage                      ocupação do log na flash e tempo da restauração no boot
+static void cmd_storage(int argc, char** argv) {
+    StorageStats stats;
+    storage_get_stats(&stats);
+    printf("segmento %u (seq %lu): %u de %u registros\n", stats.segment, (unsigned long)stats.seq,
+           stats.used, stats.capacity);
+    printf("paginas gravadas: %lu, erros: %lu, regravados: %lu\n", (unsigned long)stats.page_writes,
+           (unsigned long)stats.errors, (unsigned long)stats.requeued);
+    printf("boot: %lu registros em %lu us\n", (unsigned long)stats.restored, (unsigned long)stats.restore_us);
+}
+
+// tasks                        CPU de cada tarefa desde o tasks anterior e menor folga de pilha
+static void cmd_tasks(int argc, char** argv) {
+    DiagTask tasks[DIAG_MAX_TASKS];
+    uint32_t window_ms;
+    int n = diag_get_tasks(tasks, DIAG_MAX_TASKS, &window_ms);
+
+    printf("%-10s est pri   cpu  pilha livre\n", "tarefa");
+    for (int i = 0; i < n; i++) {
+        printf("%-10s  %c  %2u %3u.%u%% %7lu B\n", tasks[i].name, tasks[i].state, tasks[i].priority,
+               tasks[i].cpu_permille / 10, tasks[i].cpu_permille % 10, (unsigned long)tasks[i].stack_free);
+    }
+    printf("intervalo: %lu ms\n", (unsigned long)window_ms);
+}
+
+// diag                         heap, filas, tráfego do I2C e quadros enviados ao display
+static void cmd_diag(int argc, char** argv) {
+    DiagSystem stats;
+    DiagQueue queues[DIAG_MAX_QUEUES];
+    int n = diag_get_queues(queues, DIAG_MAX_QUEUES);
+    diag_get_system(&stats);
+
+    printf("heap: %lu B livres, minimo %lu B\n", (unsigned long)stats.heap_free, (unsigned long)stats.heap_min);
+    for (int i = 0; i < n; i++) {
+        if (queues[i].mutex) {
+            printf("mutex %-9s %s\n", queues[i].name, queues[i].waiting ? "livre" : "ocupado");
+        } else {
+            printf("fila %-10s %2u de %2u, pico %2u\n", queues[i].name, queues[i].waiting, queues[i].length,
+                   queues[i].peak);
+        }
+    }
+    printf("i2c: %lu B/s, %lu transacoes/s (total %lu B, %lu transacoes)\n",
+           (unsigned long)stats.i2c_bytes_per_s, (unsigned long)stats.i2c_transactions_per_s,
+           (unsigned long)stats.i2c_bytes, (unsigned long)stats.i2c_transactions);
+    printf("quadros: %lu/s (total %lu)\n", (unsigned long)stats.frames_per_s, (unsigned long)stats.frames);
+    UiStats ui;
+    ui_get_stats(&ui);
+    printf("tela: %lu atualizacoes, %lu sem mudanca, %lu inteiras, %lu widgets desenhados\n",
+           (unsigned long)ui.refreshes, (unsigned long)ui.idle, (unsigned long)ui.full,
+           (unsigned long)ui.widgets);
+    printf("intervalo: %lu ms\n", (unsigned long)stats.window_ms);
+}
+
+// i2c                          contadores do barramento do display
+// i2c 100|400|1000             troca a frequência (kHz), aplicada pelo display entre dois quadros
+static void cmd_i2c(int argc, char** argv) {
+    if (argc == 2) {
+        unsigned long khz = strtoul(argv[1], NULL, 10);
+        if (khz != 100 && khz != 400 && khz != 1000) {
+            printf("uso: i2c [100|400|1000]\n");
+            return;
+        }
+        i2c_bus_request_baudrate(khz * 1000);
+        return;
+    }
+
+    const struct i2c_bus_stats* bus = i2c_bus_get_stats();
+    printf("%lu kHz: %lu transacoes, %lu bytes\n", (unsigned long)bus->baudrate / 1000,
+           (unsigned long)bus->transactions, (unsigned long)bus->bytes);
+    printf("NAK: %lu, prazo estourado: %lu, recuperacoes: %lu (SDA preso: %lu), descidas: %lu\n",
+           (unsigned long)bus->naks, (unsigned long)bus->timeouts, (unsigned long)bus->recoveries,
+           (unsigned long)bus->stuck, (unsigned long)bus->downshifts);
+}
+
+// lat                          latência da entrada até a vUI e do disparo até a vAlert
+// lat clear                    zera as medidas
+static void cmd_lat(int argc, char** argv) {
+    static const char* const names[DIAG_LAT_COUNT] = {"entrada", "alarme"};
+
+    if (argc == 2 && strcmp(argv[1], "clear") == 0) {
+        diag_clear_latency();
+        return;
+    }
+    for (int i = 0; i < DIAG_LAT_COUNT; i++) {
+        DiagLatency lat;
+        diag_get_latency(i, &lat);
+        printf("%-8s %5lu amostras, min %6lu us, media %6lu us, max %6lu us, jitter %6lu us\n", names[i],
+               (unsigned long)lat.count, (unsigned long)lat.min_us, (unsigned long)lat.avg_us,
+               (unsigned long)lat.max_us, (unsigned long)(lat.max_us - lat.min_us));
+    }
+}
+
+// alerts                       contadores do despacho de alertas
+static void cmd_alerts(int argc, char** argv) {
+    AlertStats stats;
+    alert_get_stats(&stats);
+    printf("disparos: %lu, na tela: %lu, juntados: %lu\n", (unsigned long)stats.fired, (unsigned long)stats.shown,
+           (unsigned long)stats.coalesced);
+    printf("adiados: %lu, descartados: %lu\n", (unsigned long)stats.snoozed, (unsigned long)stats.dropped);
+    printf("agora: %u pendentes, %u adiados\n", stats.pending, stats.snoozing);
+}
+
+// trace                        despeja os eventos gravados (ver tools/trace2chrome.py)
+// trace on|off|clear           liga, desliga ou esvazia a gravação
+static void cmd_trace(int argc, char** argv) {
+    if (argc == 1) trace_dump();
+    else if (strcmp(argv[1], "on") == 0) trace_enable(true);
+    else if (strcmp(argv[1], "off") == 0) trace_enable(false);
+    else if (strcmp(argv[1], "clear") == 0) trace_clear();
+    else printf("uso: trace [on | off | clear]\n");
+}
+
+static const ShellCommand commands[] = {
+    {"help", "lista os comandos", cmd_help},
+    {"time", "mostra ou acerta o relogio", cmd_time},
+    {"power", "acordadas por hora e consumo estimado", cmd_power},
+    {"list", "lista os lembretes", cmd_list},
+    {"add", "adiciona um lembrete", cmd_add},
+    {"del", "remove um lembrete", cmd_del},
+    {"storage", "estado do log de lembretes na flash", cmd_storage},
+    {"tasks", "CPU e pilha de cada tarefa", cmd_tasks},
+    {"diag", "heap, filas, I2C, quadros e tela", cmd_diag},
+    {"i2c", "barramento do display: erros e frequencia", cmd_i2c},
+    {"lat", "latencia da entrada e dos alarmes", cmd_lat},
+    {"alerts", "contadores dos alertas", cmd_alerts},
+    {"trace", "despeja ou controla o trace de eventos", cmd_trace},
+};
+
+static void cmd_help(int argc, char** argv) {
+    for (int i = 0; i < count_of(commands); i++) {
+        printf("%-8s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+// === Leitura de linhas ===
+static void execute(char* line) {
+    char* argv[SHELL_MAX_ARGS];
+    int argc = 0;
+
+    for (char* tok = strtok(line, " \t"); tok && argc < SHELL_MAX_ARGS; tok = strtok(NULL, " \t")) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) return;
+
+    for (int i = 0; i < count_of(commands); i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) {
+            commands[i].run(argc, argv);
+            return;
+        }
+    }
+    printf("comando desconhecido: %s (help lista os comandos)\n", argv[0]);
+}
+
+// Chamado pelo stdio (em contexto de interrupção) quando há caracteres para ler
+static void on_chars_available(void* ctx) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(hShell, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void vShell(void* p) {
+    char line[SHELL_LINE_LEN];
+    char chunk[SHELL_CHUNK_LEN];
+    int len = 0;
+
+    while (1) {
+        // No meio de um quadro binário a espera tem prazo: o quadro interrompido é descartado
+        TickType_t wait = link_receiving() ? pdMS_TO_TICKS(LINK_TIMEOUT_MS) : portMAX_DELAY;
+        if (!ulTaskNotifyTake(pdTRUE, wait)) {
+            link_reset();
+            continue;
+        }
+
+        // Em blocos: uma importação chega em milhares de bytes seguidos
+        int n;
+        while ((n = stdio_get_until(chunk, sizeof chunk, get_absolute_time())) > 0) {
+            for (int i = 0; i < n; i++) {
+                uint8_t c = chunk[i];
+                if (link_receiving() || (len == 0 && c == LINK_SYNC)) {
+                    link_feed(c);
+                } else if (c == '\r' || c == '\n') {
+                    line[len] = '\0';
+                    execute(line);
+                    len = 0;
+                } else if (len < SHELL_LINE_LEN - 1) {
+                    line[len++] = (char)c;
+                }
+            }
+        }
+    }
+}
+
+void shell_init(void) {
+    hShell = xTaskCreateStatic(vShell, "Shell", SHELL_STACK_WORDS, NULL, 1, shell_stack, &shell_tcb);
+    stdio_set_chars_available_callback(on_chars_available, NULL);
+}
@@ -0,0 +1,18 @@
+#ifndef SHELL_H
+#define SHELL_H
+
+#define SHELL_LINE_LEN 80
+#define SHELL_CHUNK_LEN 64    // bytes lidos do stdio por vez (um pacote USB)
+#define SHELL_MAX_ARGS 8
+#define SHELL_STACK_WORDS 512
+
+// Comando do shell serial: recebe os argumentos já separados por espaço (argv[0] é o nome)
+typedef struct {
+    const char* name;
+    const char* help;
+    void (*run)(int argc, char** argv);
+} ShellCommand;
+
+void shell_init(void);
+
+#endif
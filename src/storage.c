@@ -0,0 +1,318 @@
+// === Persistência dos lembretes na flash ===
+// Log estruturado numa faixa reservada no fim da flash. Cada segmento começa com um
+// cabeçalho com número de sequência e guarda registros de 32 bytes: um retrato completo dos
+// lembretes, gravado na compactação, seguido das alterações posteriores. A compactação passa
+// para o segmento seguinte do anel, o que distribui os apagamentos entre todos eles, e o
+// cabeçalho é gravado por último, então o segmento antigo continua valendo até o novo estar
+// completo. No boot só o segmento mais novo é lido.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "reminder.h"
+#include "storage.h"
+#include "diag.h"
+#include <assert.h>
+#include <string.h>
+
+#define STORAGE_OFFSET (PICO_FLASH_SIZE_BYTES - STORAGE_SIZE)
+#define RECORD_SIZE 32
+#define RECORDS_PER_SEGMENT (STORAGE_SEGMENT_SIZE / RECORD_SIZE)
+#define RECORDS_PER_PAGE (FLASH_PAGE_SIZE / RECORD_SIZE)
+#define FLASH_TIMEOUT_MS 100
+#define COMPACT_IDLE_MS 5000
+#define RETRY_MS 1000
+
+enum { REC_ERASED = 0xFF, REC_HEADER = 'H', REC_PUT = 'P', REC_DEL = 'D' };
+
+typedef struct {
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t crc;
+    uint32_t seq;       // só no cabeçalho
+    Reminder r;
+} Record;
+
+static_assert(sizeof(Record) == RECORD_SIZE, "registro deve ocupar 32 bytes");
+static_assert(RECORDS_PER_SEGMENT >= 2 * MAX_REMINDERS, "o retrato deve caber com folga num segmento");
+
+static int segment;
+static uint32_t seq;
+static int next_slot;                   // próximo registro livre do segmento atual
+static uint8_t page[FLASH_PAGE_SIZE];   // imagem da página que está recebendo registros
+static int page_first;                  // primeiro registro da página em "page"
+static bool page_pending;
+static uint32_t queued[(MAX_REMINDERS + 31) / 32];  // ids já na fila
+static QueueHandle_t qStorage;
+static StaticQueue_t qStorage_buf;
+static uint16_t qStorage_storage[MAX_REMINDERS];
+static StaticTask_t storage_tcb;
+static StackType_t storage_stack[STORAGE_STACK_WORDS];
+static StorageStats stats;
+
+static uint32_t segment_offset(int seg) {
+    return STORAGE_OFFSET + seg * STORAGE_SEGMENT_SIZE;
+}
+
+static const Record* flash_record(int seg, int slot) {
+    return (const Record*)(XIP_BASE + segment_offset(seg) + slot * RECORD_SIZE);
+}
+
+// CRC-16/CCITT do registro com o campo crc zerado
+static uint16_t record_crc(const Record* rec) {
+    Record tmp = *rec;
+    tmp.crc = 0;
+
+    const uint8_t* p = (const uint8_t*)&tmp;
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < RECORD_SIZE; i++) {
+        crc ^= p[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static bool record_erased(const Record* rec) {
+    const uint32_t* w = (const uint32_t*)rec;
+    for (int i = 0; i < RECORD_SIZE / 4; i++) {
+        if (w[i] != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+static bool record_valid(const Record* rec) {
+    return rec->type != REC_ERASED && rec->crc == record_crc(rec);
+}
+
+// === Acesso à flash ===
+// Apagar ou gravar desliga o XIP; flash_safe_execute garante que nada (outro núcleo ou
+// interrupção) executa da flash enquanto isso
+typedef struct {
+    uint32_t offset;
+    const uint8_t* data;    // NULL: apagar
+    size_t len;
+} FlashOp;
+
+static void run_flash_op(void* p) {
+    const FlashOp* op = p;
+    if (op->data) flash_range_program(op->offset, op->data, op->len);
+    else flash_range_erase(op->offset, op->len);
+}
+
+static bool flash_op(uint32_t offset, const uint8_t* data, size_t len) {
+    FlashOp op = {offset, data, len};
+    if (flash_safe_execute(run_flash_op, &op, FLASH_TIMEOUT_MS) == PICO_OK) return true;
+    stats.errors++;
+    return false;
+}
+
+// === Log ===
+// Grava a página em montagem; os registros que já estavam gravados recebem o mesmo valor de
+// novo e os ainda livres continuam em 0xFF
+static bool commit(void) {
+    if (!page_pending) return true;
+    page_pending = false;
+    stats.page_writes++;
+    return flash_op(segment_offset(segment) + page_first * RECORD_SIZE, page, FLASH_PAGE_SIZE);
+}
+
+// Acrescenta um registro à página em montagem, gravando a anterior se ela encheu
+static bool stage(Record* rec) {
+    if (next_slot >= RECORDS_PER_SEGMENT) return false;
+    if (next_slot % RECORDS_PER_PAGE == 0) {
+        if (!commit()) return false;
+        memset(page, 0xFF, sizeof page);
+        page_first = next_slot;
+    }
+    rec->crc = record_crc(rec);
+    memcpy(page + (next_slot - page_first) * RECORD_SIZE, rec, RECORD_SIZE);
+    next_slot++;
+    page_pending = true;
+    return true;
+}
+
+// Registro com o estado atual do lembrete "id": inclusão/alteração, ou remoção se não existe mais
+static void snapshot(int id, Record* rec) {
+    memset(rec, 0, sizeof *rec);
+
+    taskENTER_CRITICAL();
+    const Reminder* r = reminder_get(id);
+    rec->type = r ? REC_PUT : REC_DEL;
+    if (r) rec->r = *r;
+    taskEXIT_CRITICAL();
+    rec->r.id = id;
+}
+
+// Copia todos os lembretes para o próximo segmento do anel e só então grava o cabeçalho dele
+static bool write_segment(int target) {
+    // Um setor por vez: cada apagamento deixa as interrupções desligadas por dezenas de ms
+    for (int s = 0; s < STORAGE_SEGMENT_SIZE / FLASH_SECTOR_SIZE; s++) {
+        if (!flash_op(segment_offset(target) + s * FLASH_SECTOR_SIZE, NULL, FLASH_SECTOR_SIZE)) return false;
+    }
+
+    segment = target;
+    next_slot = 1;
+    page_first = 0;
+    page_pending = false;
+    memset(page, 0xFF, sizeof page);
+
+    Record rec;
+    for (int id = 0; id < MAX_REMINDERS; id++) {
+        if (!reminder_get(id)) continue;
+        snapshot(id, &rec);
+        if (rec.type == REC_PUT && !stage(&rec)) return false;
+    }
+    if (!commit()) return false;
+
+    uint8_t header[FLASH_PAGE_SIZE];
+    memset(header, 0xFF, sizeof header);
+    rec = (Record){.type = REC_HEADER, .seq = seq + 1};
+    rec.crc = record_crc(&rec);
+    memcpy(header, &rec, RECORD_SIZE);
+
+    // A página 0 em montagem não tem o cabeçalho, mas 0xFF nessa posição não o altera
+    return flash_op(segment_offset(segment), header, FLASH_PAGE_SIZE);
+}
+
+static void compact(void) {
+    int old = segment;
+    commit();
+    if (write_segment((old + 1) % STORAGE_SEGMENTS)) {
+        seq++;
+    } else {
+        // O segmento antigo continua sendo o válido; nada é gravado até a próxima tentativa
+        segment = old;
+        next_slot = RECORDS_PER_SEGMENT;
+        page_pending = false;
+    }
+}
+
+// === Restauração ===
+// Procura o cabeçalho mais novo e aplica os registros do segmento até o primeiro livre
+static void restore(void) {
+    uint64_t start = time_us_64();
+    int best = -1;
+
+    for (int s = 0; s < STORAGE_SEGMENTS; s++) {
+        const Record* h = flash_record(s, 0);
+        if (h->type != REC_HEADER || !record_valid(h)) continue;
+        if (best < 0 || (int32_t)(h->seq - seq) > 0) {
+            best = s;
+            seq = h->seq;
+        }
+    }
+
+    if (best < 0) {
+        // Flash nova: a primeira compactação cria o segmento 0
+        segment = STORAGE_SEGMENTS - 1;
+        next_slot = RECORDS_PER_SEGMENT;
+        seq = 0;
+    } else {
+        segment = best;
+        for (next_slot = 1; next_slot < RECORDS_PER_SEGMENT; next_slot++) {
+            const Record* rec = flash_record(segment, next_slot);
+            if (record_erased(rec)) break;
+            if (!record_valid(rec)) {
+                // Gravação interrompida: o resto do segmento não é confiável, compacta já
+                next_slot = RECORDS_PER_SEGMENT;
+                break;
+            }
+
+            if (rec->type == REC_PUT) reminder_put(&rec->r);
+            else if (rec->type == REC_DEL) reminder_remove(rec->r.id);
+            stats.restored++;
+        }
+
+        if (next_slot % RECORDS_PER_PAGE) {
+            page_first = next_slot - next_slot % RECORDS_PER_PAGE;
+            memcpy(page, flash_record(segment, page_first), FLASH_PAGE_SIZE);
+        }
+    }
+    stats.restore_us = time_us_64() - start;
+}
+
+// Chamado por reminder.c a cada mudança: só enfileira o id, a gravação fica com vStorage
+static void on_change(int id) {
+    taskENTER_CRITICAL();
+    bool already = queued[id / 32] & (1u << (id % 32));
+    queued[id / 32] |= 1u << (id % 32);
+    taskEXIT_CRITICAL();
+
+    uint16_t item = id;
+    if (!already) xQueueSend(qStorage, &item, 0);
+}
+
+// Um lote não chegou à flash: os ids voltam à fila e a próxima gravação abre um segmento novo,
+// com o retrato completo, em vez de continuar numa página que pode ter ficado pela metade
+static void requeue(const uint32_t* batch) {
+    next_slot = RECORDS_PER_SEGMENT;
+    page_pending = false;
+
+    for (int w = 0; w < (MAX_REMINDERS + 31) / 32; w++) {
+        for (uint32_t bits = batch[w]; bits; bits &= bits - 1) {
+            uint16_t id = w * 32 + __builtin_ctz(bits);
+            taskENTER_CRITICAL();
+            bool already = queued[w] & (1u << (id % 32));
+            queued[w] |= 1u << (id % 32);
+            taskEXIT_CRITICAL();
+            if (!already) xQueueSend(qStorage, &id, 0);
+            stats.requeued++;
+        }
+    }
+}
+
+static void vStorage(void* p) {
+    uint16_t id;
+    while (1) {
+        if (next_slot >= RECORDS_PER_SEGMENT) compact();
+
+        // Com o segmento quase cheio, a espera tem prazo: sem alterações, compacta antes de encher,
+        // para que uma gravação nunca espere o apagamento. Fora disso, dorme até a próxima alteração
+        bool filling = next_slot > RECORDS_PER_SEGMENT * 3 / 4;
+        if (!xQueueReceive(qStorage, &id, filling ? pdMS_TO_TICKS(COMPACT_IDLE_MS) : portMAX_DELAY)) {
+            compact();
+            continue;
+        }
+
+        // Tudo que já está na fila vai na mesma gravação de página
+        uint32_t batch[(MAX_REMINDERS + 31) / 32] = {0};
+        bool ok = true;
+        do {
+            taskENTER_CRITICAL();
+            queued[id / 32] &= ~(1u << (id % 32));
+            taskEXIT_CRITICAL();
+            batch[id / 32] |= 1u << (id % 32);
+
+            if (next_slot >= RECORDS_PER_SEGMENT) compact();
+            Record rec;
+            snapshot(id, &rec);
+            ok = stage(&rec);
+        } while (ok && xQueueReceive(qStorage, &id, 0));
+
+        if (!ok || !commit()) {
+            requeue(batch);
+            vTaskDelay(pdMS_TO_TICKS(RETRY_MS));
+        }
+    }
+}
+
+// Restaura os lembretes (antes de o agendador começar) e passa a registrar as mudanças
+void storage_init(void) {
+    restore();
+    qStorage = xQueueCreateStatic(MAX_REMINDERS, sizeof(uint16_t), (uint8_t*)qStorage_storage, &qStorage_buf);
+    diag_add_queue("Storage", qStorage);
+    reminder_set_listener(on_change);
+    xTaskCreateStatic(vStorage, "Storage", STORAGE_STACK_WORDS, NULL, 1, storage_stack, &storage_tcb);
+}
+
+void storage_get_stats(StorageStats* out) {
+    *out = stats;
+    out->segment = segment;
+    out->seq = seq;
+    out->used = next_slot < RECORDS_PER_SEGMENT ? next_slot : RECORDS_PER_SEGMENT;
+    out->capacity = RECORDS_PER_SEGMENT;
+}
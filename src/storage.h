@@ -0,0 +1,28 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <stdint.h>
+#include "hardware/flash.h"
+
+// Faixa reservada no fim da flash: segmentos de 16 KB usados em anel
+#define STORAGE_SEGMENTS 4
+#define STORAGE_SEGMENT_SIZE (4 * FLASH_SECTOR_SIZE)
+#define STORAGE_SIZE (STORAGE_SEGMENTS * STORAGE_SEGMENT_SIZE)
+
+typedef struct {
+    uint8_t segment;
+    uint32_t seq;            // número de compactações desde a primeira gravação
+    uint16_t used, capacity; // registros ocupados no segmento atual
+    uint32_t page_writes;
+    uint32_t errors;
+    uint32_t requeued;       // alterações devolvidas à fila depois de uma falha de gravação
+    uint32_t restored;       // registros lidos no boot
+    uint32_t restore_us;
+} StorageStats;
+
+#define STORAGE_STACK_WORDS 384
+
+void storage_init(void);
+void storage_get_stats(StorageStats* stats);
+
+#endif
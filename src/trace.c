@@ -0,0 +1,134 @@
+// === Trace de eventos ===
+// Um anel por núcleo, escrito só por ele: a troca de tarefa, as filas e mutexes registrados
+// (macros trace* do FreeRTOSConfig.h) e os trechos do firmware viram registros de 8 bytes com
+// o instante em µs do timer, que é o mesmo para os dois núcleos. A escrita mascara as
+// interrupções do próprio núcleo por alguns ciclos, então não há trava entre os núcleos e
+// quem grava nunca espera. O comando "trace" do shell despeja os anéis em texto, convertido
+// para o formato do Chrome/Perfetto por tools/trace2chrome.py.
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "diag.h"
+#include "trace.h"
+#include <stdio.h>
+
+typedef struct {
+    uint32_t time_us;
+    char kind;          // S troca de tarefa, q/Q envio/recebimento na fila, m/M mutex devolvido/tomado,
+                        // B/E início/fim de trecho, I marca instantânea
+    uint8_t id;         // fila, mutex ou marca
+    uint16_t value;     // tarefa, ocupação da fila ou valor da marca
+} TraceEvent;
+
+static TraceEvent rings[TRACE_CORES][TRACE_RING_LEN];
+static volatile uint32_t heads[TRACE_CORES];
+static volatile bool enabled = true;
+
+static const char* const mark_names[TRACE_MARK_COUNT] = {
+    [TRACE_RENDER] = "render",
+    [TRACE_FLUSH] = "flush",
+    [TRACE_BEEP] = "beep",
+    [TRACE_ALERT] = "alert",
+    [TRACE_BTN_EDGE] = "btn_edge",
+    [TRACE_BTN_PRESS] = "btn_press",
+};
+
+static void record(char kind, uint8_t id, uint16_t value) {
+    if (!enabled) return;
+
+    uint32_t irq = save_and_disable_interrupts();
+    uint core = get_core_num();
+    TraceEvent* e = &rings[core][heads[core] & (TRACE_RING_LEN - 1)];
+    e->time_us = time_us_32();
+    e->kind = kind;
+    e->id = id;
+    e->value = value;
+    heads[core]++;
+    restore_interrupts(irq);
+}
+
+// === Ganchos do FreeRTOS ===
+// traceTASK_SWITCHED_IN, com o número da tarefa que passa a rodar neste núcleo
+void trace_task_switched_in(unsigned long task) {
+    record('S', 0, task);
+}
+
+// traceQUEUE_SEND/RECEIVE das filas registradas, com a fila travada; nos mutexes, enviar é
+// devolver e receber é tomar
+void trace_queue(unsigned long send, unsigned long type, unsigned long number, unsigned long waiting) {
+    bool mutex = type == queueQUEUE_TYPE_MUTEX || type == queueQUEUE_TYPE_RECURSIVE_MUTEX;
+    char kind = mutex ? (send ? 'm' : 'M') : (send ? 'q' : 'Q');
+    record(kind, number, waiting);
+}
+
+// === Trechos do firmware ===
+void trace_begin(TraceMark mark, uint16_t value) {
+    record('B', mark, value);
+}
+
+void trace_end(TraceMark mark) {
+    record('E', mark, 0);
+}
+
+void trace_instant(TraceMark mark, uint16_t value) {
+    record('I', mark, value);
+}
+
+void trace_enable(bool on) {
+    enabled = on;
+}
+
+void trace_clear(void) {
+    bool was = enabled;
+    enabled = false;
+    for (int c = 0; c < TRACE_CORES; c++) heads[c] = 0;
+    enabled = was;
+}
+
+// === Dump ===
+// trace 1 <núcleos>
+// task <número> <nome>          tarefas existentes (o nome pode ter espaços)
+// object <número> queue|mutex <nome>
+// mark <id> <nome>
+// core <núcleo> <gravados> <perdidos>
+// ev <núcleo> <µs> <tipo> <id> <valor>
+// end
+void trace_dump(void) {
+    // A gravação fica parada durante o dump, para o anel não ser sobrescrito enquanto é lido
+    bool was = enabled;
+    enabled = false;
+
+    printf("trace 1 %d\n", TRACE_CORES);
+
+    static TaskStatus_t tasks[DIAG_MAX_TASKS];
+    int n = uxTaskGetSystemState(tasks, DIAG_MAX_TASKS, NULL);
+    for (int i = 0; i < n; i++) {
+        printf("task %lu %s\n", (unsigned long)tasks[i].xTaskNumber, tasks[i].pcTaskName);
+    }
+
+    DiagQueue queues[DIAG_MAX_QUEUES];
+    n = diag_get_queues(queues, DIAG_MAX_QUEUES);
+    for (int i = 0; i < n; i++) {
+        printf("object %d %s %s\n", i + 1, queues[i].mutex ? "mutex" : "queue", queues[i].name);
+    }
+
+    for (int i = 0; i < TRACE_MARK_COUNT; i++) {
+        printf("mark %d %s\n", i, mark_names[i]);
+    }
+
+    for (int c = 0; c < TRACE_CORES; c++) {
+        uint32_t head = heads[c];
+        uint32_t first = head > TRACE_RING_LEN ? head - TRACE_RING_LEN : 0;
+        printf("core %d %lu %lu\n", c, (unsigned long)(head - first), (unsigned long)first);
+
+        for (uint32_t i = first; i != head; i++) {
+            const TraceEvent* e = &rings[c][i & (TRACE_RING_LEN - 1)];
+            printf("ev %d %lu %c %u %u\n", c, (unsigned long)e->time_us, e->kind, e->id, e->value);
+        }
+    }
+    printf("end\n");
+
+    enabled = was;
+}
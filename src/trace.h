@@ -0,0 +1,33 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Eventos guardados por núcleo (potência de 2); os mais antigos são sobrescritos
+#define TRACE_RING_LEN 512
+#define TRACE_CORES 2
+
+// Trechos e marcas do próprio firmware; os nomes saem no dump para o conversor
+typedef enum {
+    TRACE_RENDER,       // comando de tela aplicado ao framebuffer
+    TRACE_FLUSH,        // quadro em envio pelo DMA
+    TRACE_BEEP,         // nota do buzzer (valor: frequência em Hz)
+    TRACE_ALERT,        // lembrete recebido pela vAlert
+    TRACE_BTN_EDGE,     // borda no GPIO de um botão (interrupção)
+    TRACE_BTN_PRESS,    // toque confirmado pelo debounce
+    TRACE_MARK_COUNT
+} TraceMark;
+
+// Trecho com duração (início e fim no mesmo núcleo) e marca instantânea; "value" vai junto
+void trace_begin(TraceMark mark, uint16_t value);
+void trace_end(TraceMark mark);
+void trace_instant(TraceMark mark, uint16_t value);
+
+void trace_enable(bool on);
+void trace_clear(void);
+
+// Escreve o conteúdo dos anéis no stdio, no formato lido por tools/trace2chrome.py
+void trace_dump(void);
+
+#endif
@@ -0,0 +1,139 @@
+// === Interface retida ===
+// As telas são listas de widgets ligados ao estado da interface. A cada ui_refresh, a chave de
+// cada widget é comparada à do último desenho e só os que mudaram viram comandos ao display;
+// sem mudança, nada é enviado, e o servidor do display e o barramento ficam parados. Trocar de
+// tela desenha a nova inteira.
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "inc/ssd1306.h"
+#include "display.h"
+#include "ui.h"
+#include <stdio.h>
+
+static SemaphoreHandle_t uiMutex;
+static StaticSemaphore_t uiMutex_buf;
+static const UiScreen* current;
+static bool full;                       // a tela atual ainda não foi desenhada inteira
+static uint32_t keys[UI_MAX_WIDGETS];   // chave de cada widget no último desenho
+static UiStats stats;
+
+static uint32_t widget_key(const UiWidget* w) {
+    switch (w->type) {
+        case UI_LABEL:
+            return w->label.key ? w->label.key() : 0;
+        case UI_TIME:
+            return *w->time.hour | *w->time.minute << 8 | (uint32_t)*w->time.option << 16;
+        case UI_LIST:
+            // 9 bits para a seleção (até 256 lembretes); o resto para a revisão das linhas
+            return (uint32_t)*w->list.selected | w->list.revision() << 9;
+        case UI_BANNER:
+            return w->banner.key();
+        default:
+            return 0;
+    }
+}
+
+static void text_at(const UiWidget* w, uint8_t y, const char* text) {
+    int x = w->x;
+    if (w->flags & UI_CENTER) {
+        int pad = (w->w - ssd1306_string_width(text)) / 2;
+        if (pad > 0) x += pad;
+    }
+    display_text(x, y, text);
+}
+
+static void widget_draw(const UiWidget* w) {
+    char text[DISPLAY_TEXT_LEN];
+
+    switch (w->type) {
+        case UI_LABEL:
+            display_clear_region(w->x, w->y, w->w, w->h);
+            if (w->label.text) {
+                text_at(w, w->y, w->label.text);
+            } else {
+                w->label.format(text, sizeof text);
+                text_at(w, w->y, text);
+            }
+            break;
+
+        case UI_TIME:
+            snprintf(text, sizeof text, "%02u:%02u %s", *w->time.hour, *w->time.minute,
+                     w->time.option_label(*w->time.option));
+            display_clear_region(w->x, w->y, w->w, w->h);
+            text_at(w, w->y, text);
+            break;
+
+        case UI_LIST:
+            // A lista apaga e desenha a própria área; sem linhas, fica o aviso no meio dela
+            if (w->list.count() > 0) {
+                display_list(*w->list.selected);
+            } else {
+                display_clear_region(w->x, w->y, w->w, w->h);
+                text_at(w, w->y + (w->h - 8) / 2, w->list.empty);
+            }
+            break;
+
+        case UI_BANNER: {
+            display_clear_region(w->x, w->y, w->w, w->h);
+            int lines = w->banner.lines();
+            for (int i = 0; i < lines; i++) {
+                w->banner.format(i, text, sizeof text);
+                text_at(w, w->y + i * w->banner.line_h, text);
+            }
+            break;
+        }
+    }
+    stats.widgets++;
+}
+
+void ui_init(void) {
+    uiMutex = xSemaphoreCreateMutexStatic(&uiMutex_buf);
+}
+
+void ui_lock(void) {
+    xSemaphoreTake(uiMutex, portMAX_DELAY);
+}
+
+void ui_unlock(void) {
+    xSemaphoreGive(uiMutex);
+}
+
+void ui_show(const UiScreen* screen) {
+    configASSERT(screen->count <= UI_MAX_WIDGETS);
+    if (screen == current) return;
+    current = screen;
+    full = true;
+}
+
+void ui_refresh(void) {
+    if (!current) return;
+    stats.refreshes++;
+
+    // A tela do display só é aberta quando há o que desenhar
+    bool drawing = false;
+    for (int i = 0; i < current->count; i++) {
+        const UiWidget* w = &current->widgets[i];
+        uint32_t key = widget_key(w);
+        if (!full && key == keys[i]) continue;
+        keys[i] = key;
+
+        if (!drawing) {
+            drawing = true;
+            display_begin();
+            if (full) display_clear();
+        }
+        widget_draw(w);
+    }
+
+    if (drawing) {
+        display_show();
+    } else {
+        stats.idle++;
+    }
+    if (full) stats.full++;
+    full = false;
+}
+
+void ui_get_stats(UiStats* out) {
+    *out = stats;
+}
@@ -0,0 +1,79 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Widgets guardados por tela (chaves do último desenho)
+#define UI_MAX_WIDGETS 8
+
+// Texto centralizado na largura do widget
+#define UI_CENTER (1u << 0)
+
+// === Widgets ===
+// Cada widget é ligado a um estado e tem uma chave derivada dele, como as linhas da lista: só
+// os widgets cuja chave mudou desde o último desenho são redesenhados
+typedef enum {
+    UI_LABEL,       // uma linha: texto fixo, ou formatado do estado com a chave de "key"
+    UI_TIME,        // HH:MM em edição seguido do nome da opção escolhida
+    UI_LIST,        // lista com rolagem do servidor do display, ou o texto "empty" sem linhas
+    UI_BANNER       // "lines()" linhas de texto, uma a cada "line_h" pixels
+} UiWidgetType;
+
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    uint8_t x, y, w, h;         // área do widget, apagada antes de cada desenho
+    union {
+        struct {
+            const char* text;                       // NULL: o texto vem de format
+            uint32_t (*key)(void);                  // NULL: não muda enquanto a tela está
+            void (*format)(char* text, int len);
+        } label;
+        struct {
+            const uint8_t* hour;
+            const uint8_t* minute;
+            const uint8_t* option;
+            const char* (*option_label)(int option);
+        } time;
+        struct {
+            const int* selected;
+            int (*count)(void);
+            uint32_t (*revision)(void);             // muda quando alguma linha muda
+            const char* empty;
+        } list;
+        struct {
+            int (*lines)(void);
+            uint32_t (*key)(void);
+            void (*format)(int line, char* text, int len);
+            uint8_t line_h;
+        } banner;
+    };
+} UiWidget;
+
+typedef struct {
+    const UiWidget* widgets;
+    uint8_t count;
+} UiScreen;
+
+typedef struct {
+    uint32_t refreshes;     // chamadas de ui_refresh
+    uint32_t idle;          // ... em que nada mudou: nenhum comando ao display
+    uint32_t full;          // telas desenhadas inteiras (troca de tela)
+    uint32_t widgets;       // widgets redesenhados
+} UiStats;
+
+void ui_init(void);
+
+// A tela atual e as chaves são de quem segura o lock: a vUI e a vAlert trocam a tela
+void ui_lock(void);
+void ui_unlock(void);
+
+// Passa a mostrar "screen"; o próximo ui_refresh a desenha inteira. Sem efeito se já é a atual
+void ui_show(const UiScreen* screen);
+// Redesenha os widgets da tela atual cujo estado mudou, numa só tela do display
+void ui_refresh(void);
+
+void ui_get_stats(UiStats* out);
+
+#endif
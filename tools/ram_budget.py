@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Orçamento de RAM por subsistema, lido do mapa do link (Projeto_Livre.elf.map).
+
+Uso: ram_budget.py MAPA [--limit BYTES]
+Soma as seções de dados (.data, .bss, .uninitialized_data, scratch) de cada arquivo objeto e
+agrupa por subsistema: cada fonte de src/ e inc/, o kernel e o heap do FreeRTOS, o Pico SDK,
+o TinyUSB e a libc. As pilhas dos núcleos (fora das tarefas) e o que sobra para o malloc da
+newlib aparecem à parte. Com --limit, sai com código 1 se o total estático passar do limite.
+"""
+import argparse
+import re
+import sys
+
+DATA_SECTIONS = (".data", ".bss", ".uninitialized_data", ".scratch_x", ".scratch_y", ".ram_vector_table")
+STACK_SECTIONS = (".stack_dummy", ".stack1_dummy")
+MEMORIES = ("RAM", "SCRATCH_X", "SCRATCH_Y")
+
+
+def subsystem(obj, section):
+    if "heap_" in obj and "ucHeap" in section:
+        return "FreeRTOS heap"
+    path = obj.replace("\\", "/")
+    if "FreeRTOS" in path or "freertos" in path.lower():
+        return "FreeRTOS"
+    m = re.search(r"/(src|inc|bench|sim)/([^/]+?)\.c\.(obj|o)$", path)
+    if m:
+        return f"{m.group(1)}/{m.group(2)}"
+    if "tinyusb" in path:
+        return "TinyUSB"
+    if "pico-sdk" in path or "pico_sdk" in path or "/rp2_common/" in path or "/common/" in path:
+        return "Pico SDK"
+    if re.search(r"lib(c|g|gcc|m|nosys|stdc\+\+)[^/]*\.a", path):
+        return "libc"
+    return "outros"
+
+
+def parse(lines):
+    memory, usage, stacks = {}, {}, 0
+    heap_end = None
+    out_section = None
+    pending = None
+    in_memory = False
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("Memory Configuration"):
+            in_memory = True
+            continue
+        if in_memory:
+            m = re.match(r"(\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)", line)
+            if m and m.group(1) in MEMORIES:
+                memory[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+            if line.startswith("Linker script and memory map"):
+                in_memory = False
+            continue
+
+        # Seção de saída: começa na coluna 0 (".bss  0x... 0x..." ou só o nome, quebrado)
+        m = re.match(r"^(\.[\w.]+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+))?", line)
+        if m:
+            out_section = m.group(1)
+            if out_section == ".heap" and m.group(2):
+                heap_end = int(m.group(2), 16) + int(m.group(3), 16)
+            if out_section in STACK_SECTIONS and m.group(3):
+                stacks += int(m.group(3), 16)
+            pending = None
+            continue
+        if out_section not in DATA_SECTIONS:
+            continue
+
+        # Seção de entrada: " .bss.nome  0xend  0xtam  arquivo", com o nome longo sozinho na linha
+        m = re.match(r"^ (\.[\w.$]+|COMMON)\s*$", line)
+        if m:
+            pending = m.group(1)
+            continue
+        m = re.match(r"^ (\.[\w.$]+|COMMON)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$", line)
+        if m and (m.group(1) or pending):
+            section = m.group(1) or pending
+            size = int(m.group(3), 16)
+            if size:
+                name = subsystem(m.group(4).strip(), section)
+                usage[name] = usage.get(name, 0) + size
+        pending = None
+
+    return memory, usage, stacks, heap_end
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map")
+    parser.add_argument("--limit", type=int)
+    args = parser.parse_args()
+
+    with open(args.map, errors="replace") as f:
+        memory, usage, stacks, heap_end = parse(f)
+
+    total_ram = sum(length for _, length in memory.values())
+    static = sum(usage.values())
+    width = max([len(n) for n in usage] + [24])
+
+    print(f"{'subsistema':{width}} {'bytes':>8}")
+    for name, size in sorted(usage.items(), key=lambda kv: -kv[1]):
+        print(f"{name:{width}} {size:>8}")
+    print(f"{'total estatico':{width}} {static:>8}")
+    print(f"{'pilhas dos nucleos':{width}} {stacks:>8}")
+    if "RAM" in memory and heap_end is not None:
+        origin, length = memory["RAM"]
+        print(f"{'livre para o malloc':{width}} {origin + length - heap_end:>8}")
+    if total_ram:
+        print(f"{'RAM total':{width}} {total_ram:>8}  ({(static + stacks) * 100 / total_ram:.1f}% reservada)")
+
+    if args.limit and static > args.limit:
+        print(f"ram_budget: {static} bytes estaticos passam do limite de {args.limit}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+"""Importa, exporta e compara a tabela de lembretes pela USB, com o protocolo binário do firmware.
+
+Uso: reminders.py PORTA info
+     reminders.py PORTA export [ARQUIVO.csv]
+     reminders.py PORTA import ARQUIVO.csv
+     reminders.py PORTA diff ARQUIVO.csv
+     reminders.py PORTA sync ARQUIVO.csv
+PORTA é o dispositivo serial da placa (ex.: /dev/ttyACM0). O CSV tem as colunas id, hora,
+dias, cada, prio e nome. hora é HH:MM. dias é "todos", "uteis" ou nomes como "seg,qua,sex".
+cada é o intervalo da repetição em minutos (0: uma vez por dia). Uma linha sem id vira um
+lembrete novo; com id, substitui o lembrete daquela posição. O import só acrescenta ou
+substitui. O sync também remove da placa os lembretes que não estão no arquivo. O diff só
+mostra o que o sync faria.
+"""
+import argparse
+import csv
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+SYNC = 0xA5
+REPLY = 0x80
+HELLO, EXPORT, IMPORT, DELETE, ERROR = 0x01, 0x02, 0x03, 0x04, 0xFF
+ERRORS = {1: "CRC", 2: "tamanho", 3: "tipo desconhecido", 4: "formato"}
+NO_ID = 0xFFFF
+RECORD = struct.Struct("<HBBBBH16s")
+NAME_LEN = 15
+MAX_PRIORITY = 3
+
+DAY_NAMES = ("dom", "seg", "ter", "qua", "qui", "sex", "sab")
+EVERY_DAY, WEEKDAYS = 0x7F, 0x3E
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+class Link:
+    def __init__(self, port, timeout=2.0):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.timeout = timeout
+        self.seq = 0
+        # Um quadro só é reconhecido no início de uma linha do shell
+        os.write(self.fd, b"\n")
+
+    def read(self, n, deadline):
+        data = b""
+        while len(data) < n:
+            left = deadline - time.monotonic()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                raise TimeoutError("a placa não respondeu")
+            data += os.read(self.fd, n - len(data))
+        return data
+
+    def request(self, kind, payload=b""):
+        self.seq = (self.seq + 1) & 0xFF
+        body = struct.pack("<BBH", kind, self.seq, len(payload)) + payload
+        os.write(self.fd, bytes([SYNC]) + body + struct.pack("<H", crc16(body)))
+
+        # Texto do shell (ecos, avisos) pode vir antes da resposta: é pulado até o byte inicial
+        deadline = time.monotonic() + self.timeout
+        while True:
+            if self.read(1, deadline)[0] != SYNC:
+                continue
+            header = self.read(4, deadline)
+            reply, seq, length = struct.unpack("<BBH", header)
+            data = self.read(length + 2, deadline)
+            if struct.unpack("<H", data[-2:])[0] != crc16(header + data[:-2]) or seq != self.seq:
+                continue
+            if reply == ERROR:
+                raise IOError(f"a placa recusou o quadro: {ERRORS.get(data[0], data[0])}")
+            if reply != kind | REPLY:
+                raise IOError(f"resposta inesperada 0x{reply:02x}")
+            return data[:-2]
+
+    def hello(self):
+        version, batch, capacity, count, changes = struct.unpack("<BBHHI", self.request(HELLO))
+        return {"version": version, "batch": batch, "capacity": capacity, "count": count, "changes": changes}
+
+    def export(self):
+        # A tabela pode mudar durante a leitura (alarme adiado, shell): repete até um retrato estável
+        while True:
+            before = self.hello()["changes"]
+            rows, start = [], 0
+            while start != NO_ID:
+                data = self.request(EXPORT, struct.pack("<H", start))
+                start, n = struct.unpack_from("<HB", data)
+                rows += [decode(data, 3 + i * RECORD.size) for i in range(n)]
+            if self.hello()["changes"] == before:
+                return rows
+
+    def import_rows(self, rows, batch):
+        ids = []
+        for i in range(0, len(rows), batch):
+            chunk = rows[i:i + batch]
+            data = self.request(IMPORT, bytes([len(chunk)]) + b"".join(encode(r) for r in chunk))
+            ids += struct.unpack_from(f"<{data[0]}H", data, 1)
+        return ids
+
+    def delete(self, ids, batch):
+        removed = 0
+        for i in range(0, len(ids), batch):
+            chunk = ids[i:i + batch]
+            removed += self.request(DELETE, bytes([len(chunk)]) + struct.pack(f"<{len(chunk)}H", *chunk))[0]
+        return removed
+
+
+# === Registros ===
+def decode(data, offset):
+    rid, hour, minute, days, prio, every, name = RECORD.unpack_from(data, offset)
+    return {"id": rid, "hour": hour, "minute": minute, "days": days, "every": every, "prio": prio,
+            "name": name.split(b"\0")[0].decode("latin-1")}
+
+
+def encode(r):
+    rid = NO_ID if r["id"] is None else r["id"]
+    name = r["name"].encode("latin-1")[:NAME_LEN]
+    return RECORD.pack(rid, r["hour"], r["minute"], r["days"], r["prio"], r["every"], name)
+
+
+def days_text(days):
+    if days == EVERY_DAY:
+        return "todos"
+    if days == WEEKDAYS:
+        return "uteis"
+    return ",".join(name for d, name in enumerate(DAY_NAMES) if days & 1 << d)
+
+
+def parse_days(text):
+    if text == "todos":
+        return EVERY_DAY
+    if text == "uteis":
+        return WEEKDAYS
+    names = [name.strip() for name in text.split(",")]
+    unknown = [name for name in names if name not in DAY_NAMES]
+    if unknown:
+        raise ValueError(f"dia {unknown[0]}: use {', '.join(DAY_NAMES)}, todos ou uteis")
+    return sum(1 << DAY_NAMES.index(name) for name in names)
+
+
+def describe(r):
+    return (f"{r['hour']:02d}:{r['minute']:02d} {days_text(r['days'])} cada {r['every']} min "
+            f"p{r['prio']} {r['name']}")
+
+
+def load(path):
+    rows = []
+    with open(path, newline="", encoding="utf-8") as f:
+        for line, row in enumerate(csv.DictReader(f), 2):
+            try:
+                hour, minute = (int(x) for x in row["hora"].split(":"))
+                r = {"id": int(row["id"]) if row.get("id", "").strip() else None,
+                     "hour": hour, "minute": minute, "days": parse_days(row.get("dias") or "todos"),
+                     "every": int(row.get("cada") or 0), "prio": int(row.get("prio") or 0),
+                     "name": row["nome"].strip().upper()}
+                if not (0 <= hour < 24 and 0 <= minute < 60):
+                    raise ValueError(f"hora {row['hora']}")
+                if not 0 <= r["every"] < 24 * 60:
+                    raise ValueError(f"cada {r['every']}: de 0 a 1439 minutos")
+                if not 0 <= r["prio"] <= MAX_PRIORITY:
+                    raise ValueError(f"prio {r['prio']}: de 0 a {MAX_PRIORITY}")
+                # O resto (id fora do u16, nome fora do latin-1) aparece ao montar o registro
+                encode(r)
+                rows.append(r)
+            except (KeyError, ValueError, struct.error) as e:
+                sys.exit(f"{path}:{line}: linha inválida ({e})")
+    return rows
+
+
+def save(rows, f):
+    out = csv.writer(f)
+    out.writerow(["id", "hora", "dias", "cada", "prio", "nome"])
+    for r in sorted(rows, key=lambda r: (r["hour"], r["minute"], r["id"])):
+        out.writerow([r["id"], f"{r['hour']:02d}:{r['minute']:02d}", days_text(r["days"]), r["every"],
+                      r["prio"], r["name"]])
+
+
+def same(a, b):
+    keys = ("hour", "minute", "days", "every", "prio")
+    return all(a[k] == b[k] for k in keys) and a["name"][:NAME_LEN] == b["name"][:NAME_LEN]
+
+
+def diff(board, wanted):
+    """Registros a gravar e ids a remover para a placa ficar igual ao arquivo."""
+    by_id = {r["id"]: r for r in board}
+    listed = {r["id"] for r in wanted if r["id"] is not None}
+    put = [r for r in wanted if r["id"] is not None and (r["id"] not in by_id or not same(by_id[r["id"]], r))]
+
+    # Uma linha sem id corresponde a um lembrete igual da placa que nenhuma linha com id usa:
+    # repetir o sync com o mesmo arquivo não muda nada
+    for r in (r for r in wanted if r["id"] is None):
+        match = next((b["id"] for b in board if b["id"] not in listed and same(b, r)), None)
+        if match is None:
+            put.append(r)
+        else:
+            listed.add(match)
+
+    remove = sorted(set(by_id) - listed)
+    return put, remove, by_id
+
+
+# === Comandos ===
+def report(verb, n, start):
+    elapsed = time.monotonic() - start
+    rate = f", {n / elapsed:.0f}/s" if n and elapsed > 0 else ""
+    print(f"{n} lembretes {verb} em {elapsed * 1000:.0f} ms{rate}", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("command", choices=("info", "export", "import", "diff", "sync"))
+    parser.add_argument("file", nargs="?")
+    parser.add_argument("--timeout", type=float, default=2.0, help="espera por resposta, em s")
+    args = parser.parse_args()
+    if args.command not in ("info", "export") and not args.file:
+        parser.error(f"{args.command} precisa do arquivo CSV")
+
+    link = Link(args.port, args.timeout)
+    info = link.hello()
+    start = time.monotonic()
+
+    if args.command == "info":
+        print(f"protocolo {info['version']}: {info['count']} de {info['capacity']} lembretes, "
+              f"{info['batch']} por quadro, {info['changes']} alterações desde o boot")
+
+    elif args.command == "export":
+        rows = link.export()
+        with open(args.file, "w", newline="", encoding="utf-8") if args.file else sys.stdout as f:
+            save(rows, f)
+        report("exportados", len(rows), start)
+
+    elif args.command == "import":
+        rows = load(args.file)
+        ids = link.import_rows(rows, info["batch"])
+        for r, rid in zip(rows, ids):
+            if rid == NO_ID:
+                print(f"recusado: {describe(r)}", file=sys.stderr)
+        report("importados", sum(rid != NO_ID for rid in ids), start)
+
+    else:
+        put, remove, by_id = diff(link.export(), load(args.file))
+        for r in put:
+            old = by_id.get(r["id"])
+            if old:
+                print(f"~ {r['id']:3d} {describe(old)} -> {describe(r)}")
+            else:
+                print(f"+ {'' if r['id'] is None else r['id']:>3} {describe(r)}")
+        for rid in remove:
+            print(f"- {rid:3d} {describe(by_id[rid])}")
+        if args.command == "sync":
+            removed = link.delete(remove, info["batch"])
+            ids = link.import_rows(put, info["batch"])
+            rejected = sum(rid == NO_ID for rid in ids)
+            if rejected:
+                print(f"{rejected} recusados (regra inválida ou sem espaço)", file=sys.stderr)
+            report("sincronizados", removed + len(ids) - rejected, start)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Converte o dump do comando "trace" do shell para o JSON do Chrome/Perfetto.
+
+Uso: trace2chrome.py DUMP.txt [SAIDA.json]   (sem DUMP.txt, lê da entrada padrão)
+Abra a saída em https://ui.perfetto.dev ou chrome://tracing. Cada núcleo tem uma linha com
+a tarefa em execução e outra com os trechos e marcas do firmware; as filas viram contadores
+de ocupação e cada mutex tem uma linha com os intervalos em que ficou tomado. Linhas fora do
+bloco "trace ... end" (outras saídas do shell) são ignoradas.
+"""
+import argparse
+import json
+import sys
+
+WRAP = 1 << 32
+
+
+def parse(lines):
+    tasks, objects, marks, events, lost = {}, {}, {}, {}, {}
+    inside = False
+    for line in lines:
+        line = line.strip()
+        if line.startswith("trace "):
+            inside = True
+            continue
+        if not inside:
+            continue
+        if line == "end":
+            break
+
+        kind, _, rest = line.partition(" ")
+        if kind == "task":
+            num, _, name = rest.partition(" ")
+            tasks[int(num)] = name
+        elif kind == "object":
+            num, obj_type, name = rest.split(" ", 2)
+            objects[int(num)] = (obj_type, name)
+        elif kind == "mark":
+            num, _, name = rest.partition(" ")
+            marks[int(num)] = name
+        elif kind == "core":
+            core, _, dropped = rest.split()
+            lost[int(core)] = int(dropped)
+        elif kind == "ev":
+            core, us, ev, ident, value = rest.split()
+            events.setdefault(int(core), []).append((int(us), ev, int(ident), int(value)))
+    return tasks, objects, marks, events, lost
+
+
+# O timer de 32 bits volta a zero a cada ~71 min; os eventos de um núcleo estão em ordem
+def unwrap(evs):
+    out, offset, last = [], 0, None
+    for us, ev, ident, value in evs:
+        if last is not None and us < last:
+            offset += WRAP
+        last = us
+        out.append((us + offset, ev, ident, value))
+    return out
+
+
+def convert(tasks, objects, marks, events):
+    events = {core: unwrap(evs) for core, evs in events.items()}
+    starts = [evs[0][0] for evs in events.values() if evs]
+    base = min(starts) if starts else 0
+    out = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "RP2040"}}]
+
+    def thread(tid, name):
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": name}})
+
+    for core in sorted(events):
+        thread(core * 2, f"núcleo {core}: tarefas")
+        thread(core * 2 + 1, f"núcleo {core}: trechos")
+    for num, (obj_type, name) in objects.items():
+        if obj_type == "mutex":
+            thread(100 + num, f"mutex {name}")
+
+    held = {}
+    for core, evs in sorted(events.items()):
+        running, depth = None, {}
+        for us, ev, ident, value in evs:
+            ts = us - base
+            if ev == "S":
+                if running is not None:
+                    out.append({"name": tasks.get(running[0], f"tarefa {running[0]}"), "ph": "X", "pid": 0,
+                                "tid": core * 2, "ts": running[1], "dur": ts - running[1]})
+                running = (value, ts)
+            elif ev in "qQ":
+                name = objects.get(ident, ("queue", f"fila {ident}"))[1]
+                out.append({"name": name, "ph": "C", "pid": 0, "ts": ts, "args": {"mensagens": value}})
+                out.append({"name": ("envio " if ev == "q" else "recebe ") + name, "ph": "i", "s": "t",
+                            "pid": 0, "tid": core * 2, "ts": ts})
+            elif ev == "M":
+                held[ident] = ts
+            elif ev == "m" and ident in held:
+                name = objects.get(ident, ("mutex", f"mutex {ident}"))[1]
+                start = held.pop(ident)
+                out.append({"name": f"{name} tomado", "ph": "X", "pid": 0, "tid": 100 + ident,
+                            "ts": start, "dur": ts - start})
+            elif ev in "BE":
+                name = marks.get(ident, f"marca {ident}")
+                if ev == "B":
+                    depth[ident] = depth.get(ident, 0) + 1
+                    out.append({"name": name, "ph": "B", "pid": 0, "tid": core * 2 + 1, "ts": ts,
+                                "args": {"valor": value}})
+                elif depth.get(ident, 0) > 0:
+                    # O início pode ter sido sobrescrito no anel
+                    depth[ident] -= 1
+                    out.append({"name": name, "ph": "E", "pid": 0, "tid": core * 2 + 1, "ts": ts})
+            elif ev == "I":
+                out.append({"name": marks.get(ident, f"marca {ident}"), "ph": "i", "s": "t", "pid": 0,
+                            "tid": core * 2 + 1, "ts": ts, "args": {"valor": value}})
+
+        if running is not None and evs:
+            end = evs[-1][0] - base
+            out.append({"name": tasks.get(running[0], f"tarefa {running[0]}"), "ph": "X", "pid": 0,
+                        "tid": core * 2, "ts": running[1], "dur": end - running[1]})
+
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", nargs="?")
+    parser.add_argument("output", nargs="?")
+    args = parser.parse_args()
+
+    with open(args.dump, errors="replace") if args.dump else sys.stdin as f:
+        tasks, objects, marks, events, lost = parse(f)
+    if not events:
+        sys.exit("nenhum bloco de trace encontrado")
+    for core, dropped in sorted(lost.items()):
+        if dropped:
+            print(f"núcleo {core}: {dropped} eventos mais antigos sobrescritos", file=sys.stderr)
+
+    trace = convert(tasks, objects, marks, events)
+    with open(args.output, "w") if args.output else sys.stdout as f:
+        json.dump(trace, f)
+    print(f"{len(trace['traceEvents'])} eventos", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()